@@ -173,6 +173,24 @@ namespace rml::config::helpers {
         }
     }
 
+    [[nodiscard]] inline ConfigResult<void> load_mod_config_from_string(const std::string &mod_name,
+                                                                        const std::string_view source) {
+        try {
+            auto parse_result = toml::parse(source);
+            if (!parse_result) {
+                return std::unexpected(ConfigError::parse_error);
+            }
+
+            if (auto mod_config_result = serialization::mod_config_from_toml(parse_result.table()); mod_config_result) {
+                return get_config_manager().register_mod_config(mod_name, std::move(*mod_config_result));
+            } else {
+                return std::unexpected(mod_config_result.error());
+            }
+        } catch (const std::exception &) {
+            return std::unexpected(ConfigError::io_error);
+        }
+    }
+
     [[nodiscard]] inline ConfigResult<void> save_mod_config_to_file(const std::string &mod_name,
                                                                     const std::filesystem::path &config_path) {
         try {
@@ -51,6 +51,10 @@ namespace rml::config {
             bool enable_profiling{false};
             std::size_t thread_pool_size{4};
             std::chrono::milliseconds hook_timeout{5000};
+            bool enable_bytecode_cache{true};
+            std::size_t bytecode_cache_size{64 * 1024 * 1024}; // 64MB
+            bool enable_disk_bytecode_cache{true};
+            std::size_t max_idle_lua_threads{16}; // Finished script threads each mod keeps for reuse
         } performance;
 
         struct Security {
@@ -77,6 +81,7 @@ namespace rml::config {
             bool auto_load{true};
             std::int32_t priority{0};
             std::optional<std::filesystem::path> dependencies_path;
+            std::vector<std::string> dependencies; // Mods (directory or display name) that must load first
         } runtime;
 
         struct Resources {
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+
+#include <list>
+
+namespace rml::luau {
+    // Content-addressed store of compiled Luau bytecode, shared by every lua_State and DataModel. Entries are
+    // keyed by a hash of the source, the compile options and the bytecode version, kept in a byte-bounded LRU,
+    // and optionally persisted under the owning mod's directory so unchanged scripts compile once per install.
+    class BytecodeCache final {
+    public:
+        using Bytecode = std::shared_ptr<const std::string>;
+
+        struct Key {
+            std::uint64_t source_hash{0};
+            std::uint64_t source_check{0}; // Independently seeded second hash, guards against collisions
+            std::uint64_t options_hash{0};
+            std::uint64_t source_size{0};
+
+            [[nodiscard]] bool operator==(const Key &) const noexcept = default;
+
+            [[nodiscard]] std::string to_string() const;
+        };
+
+        struct KeyHash {
+            [[nodiscard]] std::size_t operator()(const Key &key) const noexcept {
+                return static_cast<std::size_t>(key.source_hash ^ key.options_hash * 0x9E3779B97F4A7C15ull);
+            }
+        };
+
+        struct Statistics {
+            std::size_t memory_hits{0};
+            std::size_t disk_hits{0};
+            std::size_t compilations{0};
+            std::size_t evictions{0};
+            std::size_t entries{0};
+            std::size_t bytes{0};
+        };
+
+        static constexpr std::string_view DISK_CACHE_DIRECTORY = ".rml_cache/bytecode";
+
+        explicit BytecodeCache(std::size_t max_bytes = 64 * 1024 * 1024, bool enable_disk_cache = false);
+
+        ~BytecodeCache();
+
+        BytecodeCache(const BytecodeCache &) = delete;
+
+        BytecodeCache &operator=(const BytecodeCache &) = delete;
+
+        BytecodeCache(BytecodeCache &&) = delete;
+
+        BytecodeCache &operator=(BytecodeCache &&) = delete;
+
+        // Returns cached bytecode or compiles it. Compile errors are returned as Luau encodes them (a leading
+        // zero byte followed by the message) and are never cached. mod_path enables the on-disk tier.
+        [[nodiscard]] Bytecode get_or_compile(std::string_view source, const Luau::CompileOptions &options,
+                                              const std::filesystem::path &mod_path = {});
+
+        void clear() noexcept;
+
+        [[nodiscard]] Statistics get_statistics() const noexcept;
+
+        [[nodiscard]] static Key make_key(std::string_view source, const Luau::CompileOptions &options) noexcept;
+
+        [[nodiscard]] static bool is_compile_error(std::string_view bytecode) noexcept {
+            return bytecode.empty() || bytecode.front() == 0;
+        }
+
+        // The compiler's message for bytecode that is_compile_error
+        [[nodiscard]] static std::string_view compile_error_message(std::string_view bytecode) noexcept {
+            return bytecode.empty() ? std::string_view("Failed to compile source code") : bytecode.substr(1);
+        }
+
+    private:
+        struct Entry {
+            Key key;
+            Bytecode bytecode;
+        };
+
+        [[nodiscard]] Bytecode find_in_memory(const Key &key);
+
+        void insert_in_memory(const Key &key, const Bytecode &bytecode);
+
+        [[nodiscard]] static Bytecode read_from_disk(const std::filesystem::path &file, const Key &key) noexcept;
+
+        static void write_to_disk(const std::filesystem::path &file, const Key &key, const std::string &bytecode) noexcept;
+
+        std::size_t m_max_bytes;
+        bool m_enable_disk_cache;
+
+        mutable std::mutex m_mutex;
+        std::list<Entry> m_lru; // Most recently used at the front
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+        std::size_t m_bytes{0};
+
+        std::atomic<std::size_t> m_memory_hits{0};
+        std::atomic<std::size_t> m_disk_hits{0};
+        std::atomic<std::size_t> m_compilations{0};
+        std::atomic<std::size_t> m_evictions{0};
+    };
+
+    // Options every mod script and required module is compiled with, so one compiled copy (and the bytecode
+    // rmlpkg packs, built with the same levels) serves both
+    inline constexpr Luau::CompileOptions MOD_COMPILE_OPTIONS{
+        .optimizationLevel = 1,
+        .debugLevel = 2,
+    };
+
+    // Compiles through g_bytecode_cache when it exists, otherwise straight through Luau::compile.
+    [[nodiscard]] BytecodeCache::Bytecode compile_cached(std::string_view source,
+                                                         const Luau::CompileOptions &options,
+                                                         const std::filesystem::path &mod_path = {});
+
+    inline BytecodeCache *g_bytecode_cache{};
+}
@@ -2,6 +2,10 @@
 
 #include "RobloxModLoader/common.hpp"
 #include "globals_registry.hpp"
+#include "bridge_value.hpp"
+#include "lua_value.hpp"
+#include "shared_data_store.hpp"
+#include "RobloxModLoader/util/mpsc_ring_buffer.hpp"
 #include <functional>
 #include <unordered_map>
 #include <variant>
@@ -9,65 +13,128 @@
 #include <shared_mutex>
 
 namespace rml::luau::environment {
-    class LuaTable {
-    public:
-        LuaTable() = default;
+    using NativeFunctionCallback = std::function<LuaParameters(const LuaParameters &)>;
+    using EventCallback = std::function<void(const LuaParameters &)>;
 
-        template<typename T>
-        T get(const std::string &key, const T &default_value = T{}) const {
-            auto it = data_.find(key);
-            if (it == data_.end()) {
-                return default_value;
-            }
+    // Value forms of the callbacks: arguments point into the caller's arena and are only valid during the call.
+    // A native function returns values allocated from (or outliving) the arena it's given.
+    using NativeValueCallback = std::function<BridgeValues(BridgeValues, BridgeArena &)>;
+    using EventValueCallback = std::function<void(BridgeValues)>;
+    class IBridgeProvider;
 
-            if constexpr (std::is_same_v<T, std::string>) {
-                if (const auto *str_val = std::get_if<std::string>(&it->second)) {
-                    return *str_val;
-                }
-            } else if constexpr (std::is_same_v<T, double>) {
-                if (const auto *num_val = std::get_if<double>(&it->second)) {
-                    return *num_val;
-                }
-            } else if constexpr (std::is_same_v<T, bool>) {
-                if (const auto *bool_val = std::get_if<bool>(&it->second)) {
-                    return *bool_val;
-                }
-            }
+    struct EventListener {
+        size_t id;
+        EventValueCallback callback;
+    };
 
-            return default_value;
-        }
+    // Never modified once published: adding or removing a listener publishes a new list, so an emitter can run
+    // the snapshot it loaded while listeners change
+    using EventListenerSnapshot = std::shared_ptr<const std::vector<EventListener> >;
+
+    template<typename T>
+    using BridgeResult = std::expected<T, std::string>;
+
+    // Registry reference to a Luau function callable through the bridge. Slots are never removed, only emptied
+    // when their mod reloads, and are filled again by the next call or registration.
+    struct LuauFunctionSlot {
+        std::string mod_name;
+        std::string function_name;
+        lua_State *owner{nullptr}; // Main thread of the state the reference lives in
+        int ref{LUA_NOREF};
+    };
 
-        bool has_key(const std::string &key) const {
-            return data_.find(key) != data_.end();
+    // Registry references behind a callback registered from Luau, shared by its registration and the function the
+    // listener or subscription calls. A snapshot of the listeners may still hold that function after it's removed,
+    // so removal only marks it dead; the references are dropped once the last holder lets go.
+    struct LuaCallbackRefs {
+        LuaCallbackRefs(lua_State *owner, lua_State *thread, int callback_ref, int thread_ref) noexcept;
+
+        LuaCallbackRefs(const LuaCallbackRefs &) = delete;
+
+        LuaCallbackRefs &operator=(const LuaCallbackRefs &) = delete;
+
+        ~LuaCallbackRefs() noexcept;
+
+        lua_State *owner; // Main thread of the state the references live in
+        lua_State *thread; // Runs the callback; anchored by thread_ref
+        int callback_ref;
+        int thread_ref;
+        std::atomic<bool> alive{true}; // Checked before every call
+        lua_State *release_in{nullptr}; // Set on removal while the owner's state is still the live one
+    };
+
+    // Event listener or shared data subscription registered from Luau. Its references keep the callback and the
+    // thread it runs on alive until it's removed or the mod that registered it unloads.
+    struct LuaCallbackRegistration {
+        enum class Kind : std::uint8_t {
+            EventListener,
+            DataWatch
+        };
+
+        Kind kind{Kind::EventListener};
+        std::string mod_name; // Empty outside a mod
+        std::string event_name; // Listeners only
+        size_t id{0};
+        std::shared_ptr<LuaCallbackRefs> refs;
+    };
+
+    // Completion of an async bridge call. The Luau thread fills in the result once and then marks the token
+    // ready; the caller polls or waits on it from any thread.
+    class BridgeCallToken final {
+    public:
+        [[nodiscard]] bool is_ready() const noexcept {
+            return m_ready.load(std::memory_order_acquire);
         }
 
-        void set(const std::string &key, const std::variant<std::string, double, bool, std::nullptr_t> &value) {
-            data_[key] = value;
+        void wait() const noexcept {
+            m_ready.wait(false, std::memory_order_acquire);
         }
 
-        size_t size() const { return data_.size(); }
-        bool empty() const { return data_.empty(); }
+        // Only valid once is_ready()
+        [[nodiscard]] const BridgeResult<LuaParameters> &result() const noexcept {
+            return m_result;
+        }
 
-        auto begin() const { return data_.begin(); }
-        auto end() const { return data_.end(); }
+        void complete(BridgeResult<LuaParameters> result) noexcept {
+            m_result = std::move(result);
+            m_ready.store(true, std::memory_order_release);
+            m_ready.notify_all();
+        }
 
     private:
-        std::unordered_map<std::string, std::variant<std::string, double, bool, std::nullptr_t> > data_;
+        std::atomic<bool> m_ready{false};
+        BridgeResult<LuaParameters> m_result;
     };
 
-    using LuaValue = std::variant<std::string, double, bool, std::nullptr_t, LuaTable>;
-    using LuaParameters = std::vector<LuaValue>;
-    using NativeFunctionCallback = std::function<LuaParameters(const LuaParameters &)>;
-    using EventCallback = std::function<void(const LuaParameters &)>;
-    class IBridgeProvider;
+    // Runs on the Luau thread right after the token completes
+    using AsyncCallCallback = std::function<void(const BridgeResult<LuaParameters> &)>;
 
-    struct EventListener {
-        size_t id;
-        std::function<void(const LuaParameters &)> callback;
-    };
+    // Calls one Luau function repeatedly without looking it up or formatting its name. Stays valid across
+    // reloads of the mod; the function is resolved again on the first call after one.
+    class PreparedLuauCall {
+    public:
+        PreparedLuauCall() = default;
 
-    template<typename T>
-    using BridgeResult = std::expected<T, std::string>;
+        [[nodiscard]] bool is_valid() const noexcept {
+            return m_slot != nullptr;
+        }
+
+        RML_EXPORT BridgeResult<BridgeValues> call(BridgeValues parameters, BridgeArena &arena) const;
+
+        RML_EXPORT BridgeResult<LuaParameters> call(const LuaParameters &parameters) const;
+
+        // Safe from any thread; see BridgeProvider::call_luau_function_async
+        RML_EXPORT BridgeResult<std::shared_ptr<BridgeCallToken> > call_async(
+            LuaParameters parameters, AsyncCallCallback on_complete = {}) const;
+
+    private:
+        friend class BridgeProvider;
+
+        explicit PreparedLuauCall(std::shared_ptr<LuauFunctionSlot> slot) noexcept : m_slot(std::move(slot)) {
+        }
+
+        std::shared_ptr<LuauFunctionSlot> m_slot;
+    };
 
     class EventListenerHandle {
     public:
@@ -125,6 +192,39 @@ namespace rml::luau::environment {
         virtual std::vector<std::string> get_registered_mods() const = 0;
 
         virtual std::vector<std::string> get_registered_functions(std::string_view mod_name) const = 0;
+
+        // BridgeValue forms of the calls above; the LuaParameters forms convert through these
+        virtual BridgeResult<void> register_native_value_function(
+            std::string_view mod_name,
+            std::string_view function_name,
+            NativeValueCallback callback) = 0;
+
+        virtual BridgeResult<BridgeValues> call_luau_function_values(
+            std::string_view mod_name,
+            std::string_view function_name,
+            BridgeValues parameters,
+            BridgeArena &arena) const = 0;
+
+        virtual BridgeResult<std::unique_ptr<EventListenerHandle> > listen_event_values(
+            std::string_view event_name,
+            EventValueCallback callback) = 0;
+
+        virtual BridgeResult<void> trigger_event_values(
+            std::string_view event_name,
+            BridgeValues data) = 0;
+
+        virtual BridgeResult<PreparedLuauCall> prepare_luau_function(
+            std::string_view mod_name,
+            std::string_view function_name) = 0;
+
+        virtual BridgeResult<SharedDataSnapshot> get_shared_data_snapshot(
+            std::string_view key) const = 0;
+
+        virtual BridgeResult<std::size_t> subscribe_shared_data(
+            std::string_view key,
+            SharedDataCallback callback) = 0;
+
+        virtual void unsubscribe_shared_data(std::size_t subscription_id) = 0;
     };
 
     class BridgeProvider final : public GlobalProvider<BridgeProvider>, public IBridgeProvider {
@@ -166,15 +266,95 @@ namespace rml::luau::environment {
 
         std::vector<std::string> get_registered_functions(std::string_view mod_name) const override;
 
-        NativeFunctionCallback get_native_function(const std::string &full_name);
+        RML_EXPORT [[nodiscard]] BridgeResult<void> register_native_value_function(
+            std::string_view mod_name,
+            std::string_view function_name,
+            NativeValueCallback callback) override;
+
+        // Results are read into arena
+        RML_EXPORT BridgeResult<BridgeValues> call_luau_function_values(
+            std::string_view mod_name,
+            std::string_view function_name,
+            BridgeValues parameters,
+            BridgeArena &arena) const override;
+
+        RML_EXPORT BridgeResult<std::unique_ptr<EventListenerHandle> > listen_event_values(
+            std::string_view event_name,
+            EventValueCallback callback) override;
+
+        RML_EXPORT [[nodiscard]] BridgeResult<void> trigger_event_values(
+            std::string_view event_name,
+            BridgeValues data) override;
+
+        // Doesn't need the function to exist yet; it's resolved on the first call
+        RML_EXPORT [[nodiscard]] BridgeResult<PreparedLuauCall> prepare_luau_function(
+            std::string_view mod_name,
+            std::string_view function_name) override;
+
+        // Shares the stored value instead of copying it, and includes its version
+        RML_EXPORT BridgeResult<SharedDataSnapshot> get_shared_data_snapshot(
+            std::string_view key) const override;
+
+        // An empty key watches every key. Callbacks run once per changed key when the WaitingHybridScripts job
+        // steps, with the latest value, however many writes were made since the last step.
+        RML_EXPORT [[nodiscard]] BridgeResult<std::size_t> subscribe_shared_data(
+            std::string_view key,
+            SharedDataCallback callback) override;
+
+        RML_EXPORT void unsubscribe_shared_data(std::size_t subscription_id) override;
+
+        // Delivers shared data changes; like drain_async_calls, only for L of the bridge's Lua state
+        std::size_t dispatch_shared_data_changes(lua_State *L) noexcept;
+
+        [[nodiscard]] bool has_pending_shared_data_changes() const noexcept {
+            return shared_data.has_pending_changes();
+        }
+
+        // Queues the call for the Luau thread and returns immediately; safe from any thread. Queued calls run in
+        // batches when the WaitingHybridScripts job steps. Fails only if the queue is full.
+        RML_EXPORT [[nodiscard]] BridgeResult<std::shared_ptr<BridgeCallToken> > call_luau_function_async(
+            std::string_view mod_name,
+            std::string_view function_name,
+            LuaParameters parameters,
+            AsyncCallCallback on_complete = {});
+
+        // Runs up to max_calls queued async calls. Does nothing unless L belongs to the bridge's Lua state, or
+        // while another thread is draining. Returns how many calls ran.
+        std::size_t drain_async_calls(lua_State *L, std::size_t max_calls) noexcept;
+
+        [[nodiscard]] bool has_pending_async_calls() const noexcept {
+            return !async_calls.empty_approx();
+        }
+
+        // Forgets the cached functions of a mod; called when it reloads or unloads
+        void invalidate_luau_functions(std::string_view mod_name) noexcept;
+
+        // Caches the function at index as mod_name.function_name (rml.bridge.register)
+        void cache_luau_function(lua_State *L, std::string_view mod_name, std::string_view function_name,
+                                 int index);
+
+        // Shared so a call doesn't copy the std::function; empty if not registered
+        std::shared_ptr<const NativeValueCallback> get_native_function(std::string_view mod_name,
+                                                                       std::string_view function_name) const;
 
         bool has_native_function(const std::string &full_name) const;
 
-        size_t add_event_listener(const std::string &event_name, EventCallback callback);
+        size_t add_event_listener(const std::string &event_name, EventValueCallback callback);
 
         void remove_event_listener(const std::string &event_name, size_t listener_id);
 
-        std::vector<EventListener> get_event_listeners(const std::string &event_name);
+        void track_lua_callback(LuaCallbackRegistration registration);
+
+        // Removes one listener or subscription registered from Luau and drops its references. Returns false if
+        // it wasn't registered from Luau.
+        bool release_lua_callback(LuaCallbackRegistration::Kind kind, size_t id) noexcept;
+
+        // Removes the listeners and subscriptions a mod registered from Luau and drops their references; called
+        // when it reloads or unloads, so a re-run doesn't add its handlers a second time
+        void release_lua_callbacks(std::string_view mod_name) noexcept;
+
+        // One atomic load; empty if the event has no listeners
+        [[nodiscard]] EventListenerSnapshot get_event_listeners(std::string_view event_name) const noexcept;
 
         static RML_EXPORT BridgeProvider *instance();
 
@@ -194,15 +374,73 @@ namespace rml::luau::environment {
 
         static void push_lua_parameters(lua_State *L, const LuaParameters &params);
 
+        // Adapters between LuaValue and BridgeValue. Tables convert like lua_to_value: only string keys with
+        // non-table values are kept.
+        static LuaValue to_lua_value(const BridgeValue &value);
+
+        static LuaParameters to_lua_parameters(BridgeValues values);
+
+        static BridgeValue from_lua_value(const LuaValue &value, BridgeArena &arena);
+
+        static BridgeValues from_lua_parameters(const LuaParameters &parameters, BridgeArena &arena);
+
 
         mutable std::shared_mutex mutex;
         mutable std::mutex instance_mutex;
         lua_State *lua_state;
 
-        std::unordered_map<std::string, NativeFunctionCallback> native_functions;
-        std::unordered_map<std::string, LuaValue> shared_data;
-        std::unordered_map<std::string, std::vector<EventListener> > event_listeners;
+        struct NameHash {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view name) const noexcept {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        // Keyed by "mod.function"
+        std::unordered_map<std::string, std::shared_ptr<const NativeValueCallback>, NameHash, std::equal_to<> >
+        native_functions;
+        SharedDataStore shared_data;
+
+        using EventListenerMap = std::unordered_map<std::string, EventListenerSnapshot, NameHash, std::equal_to<> >;
+
+        [[nodiscard]] std::shared_ptr<LuauFunctionSlot> get_luau_function_slot(std::string_view mod_name,
+                                                                               std::string_view function_name) const;
+
+        // Callers converting the results to LuaParameters pass nested_results = false, since those keep no
+        // nested tables; reading them could only fail such a call
+        BridgeResult<BridgeValues> call_luau_slot(LuauFunctionSlot &slot, BridgeValues parameters,
+                                                  BridgeArena &arena, bool nested_results = true) const;
+
+        BridgeResult<std::shared_ptr<BridgeCallToken> > enqueue_async_call(
+            std::shared_ptr<LuauFunctionSlot> slot, LuaParameters parameters, AsyncCallCallback on_complete);
+
+        struct AsyncCall {
+            std::shared_ptr<LuauFunctionSlot> slot;
+            LuaParameters parameters;
+            std::shared_ptr<BridgeCallToken> token;
+            AsyncCallCallback on_complete;
+        };
+
+        static constexpr std::size_t ASYNC_CALL_QUEUE_CAPACITY = 16384;
+
+        util::MpscRingBuffer<AsyncCall> async_calls{ASYNC_CALL_QUEUE_CAPACITY};
+        std::atomic_flag async_drain_flag;
+
+        // Keyed by "mod.function"; the slots' owner and ref are also guarded by luau_functions_mutex
+        mutable std::mutex luau_functions_mutex;
+        mutable std::unordered_map<std::string, std::shared_ptr<LuauFunctionSlot>, NameHash, std::equal_to<> >
+        luau_functions;
+
+        // Copy-on-write: writers copy the map (only the list pointers) under event_listeners_mutex and swap it in
+        std::mutex event_listeners_mutex;
+        std::atomic<std::shared_ptr<const EventListenerMap> > event_listeners;
         std::atomic<size_t> next_listener_id;
+
+        void drop_lua_callbacks(std::span<const LuaCallbackRegistration> registrations) noexcept;
+
+        std::mutex lua_callbacks_mutex;
+        std::vector<LuaCallbackRegistration> lua_callbacks;
     };
 
     namespace lua_bridge_impl {
@@ -214,6 +452,10 @@ namespace rml::luau::environment {
 
         int get_data(lua_State *L);
 
+        int watch_data(lua_State *L);
+
+        int unwatch_data(lua_State *L);
+
         int listen_event(lua_State *L);
 
         int trigger_event(lua_State *L);
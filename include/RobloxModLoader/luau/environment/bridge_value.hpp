@@ -0,0 +1,141 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+
+namespace rml::luau::environment {
+    // Bump allocator backing the values of one bridge call. The first INLINE_CAPACITY bytes live in the arena
+    // itself, so a call that fits never touches the heap; everything is released together when it goes away.
+    class BridgeArena final {
+    public:
+        static constexpr std::size_t INLINE_CAPACITY = 1024;
+
+        BridgeArena() noexcept = default;
+
+        BridgeArena(const BridgeArena &) = delete;
+
+        BridgeArena &operator=(const BridgeArena &) = delete;
+
+        BridgeArena(BridgeArena &&) = delete;
+
+        BridgeArena &operator=(BridgeArena &&) = delete;
+
+        [[nodiscard]] void *allocate(std::size_t size, std::size_t alignment);
+
+        template<typename T>
+        [[nodiscard]] T *allocate_array(const std::size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+            return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        [[nodiscard]] bool used_heap() const noexcept {
+            return !m_blocks.empty();
+        }
+
+        // Invalidates everything allocated so far, so one arena can serve a batch of calls
+        void reset() noexcept;
+
+    private:
+        alignas(std::max_align_t) std::byte m_inline[INLINE_CAPACITY];
+        std::byte *m_cursor{m_inline};
+        std::byte *m_end{m_inline + INLINE_CAPACITY};
+        std::vector<std::unique_ptr<std::byte[]> > m_blocks;
+        std::size_t m_next_block_size{INLINE_CAPACITY * 4};
+    };
+
+    struct BridgeField;
+
+    // Flat tagged value marshalled across the bridge. Strings up to SMALL_STRING_CAPACITY bytes are stored
+    // inline; longer strings, array items and table fields point into the arena of the call that made them,
+    // so a value must not outlive its arena.
+    class BridgeValue final {
+    public:
+        enum class Kind : std::uint8_t {
+            Nil,
+            Boolean,
+            Number,
+            String,
+            Array,
+            Table
+        };
+
+        static constexpr std::size_t SMALL_STRING_CAPACITY = 16;
+
+        constexpr BridgeValue() noexcept : m_number(0.0) {
+        }
+
+        [[nodiscard]] static BridgeValue boolean(bool value) noexcept;
+
+        [[nodiscard]] static BridgeValue number(double value) noexcept;
+
+        [[nodiscard]] static BridgeValue string(std::string_view value, BridgeArena &arena);
+
+        // items and fields must already live in the arena (or outlive the value)
+        [[nodiscard]] static BridgeValue array(std::span<const BridgeValue> items) noexcept;
+
+        [[nodiscard]] static BridgeValue table(std::span<const BridgeField> fields) noexcept;
+
+        [[nodiscard]] Kind kind() const noexcept {
+            return m_kind;
+        }
+
+        [[nodiscard]] bool is_nil() const noexcept {
+            return m_kind == Kind::Nil;
+        }
+
+        // The as_* accessors return an empty value when the kind doesn't match
+        [[nodiscard]] bool as_boolean() const noexcept;
+
+        [[nodiscard]] double as_number() const noexcept;
+
+        [[nodiscard]] std::string_view as_string() const noexcept;
+
+        [[nodiscard]] std::span<const BridgeValue> as_array() const noexcept;
+
+        [[nodiscard]] std::span<const BridgeField> as_table() const noexcept;
+
+        // Field with a string key; nullptr if there is none or this isn't a table
+        [[nodiscard]] const BridgeValue *find(std::string_view key) const noexcept;
+
+    private:
+        template<typename T>
+        struct Range {
+            const T *data;
+            std::uint32_t size;
+        };
+
+        union {
+            double m_number;
+            bool m_boolean;
+            Range<char> m_string;
+            Range<BridgeValue> m_array;
+            Range<BridgeField> m_table;
+            char m_small[SMALL_STRING_CAPACITY];
+        };
+
+        Kind m_kind{Kind::Nil};
+        std::uint8_t m_small_size{0};
+    };
+
+    struct BridgeField {
+        BridgeValue key;
+        BridgeValue value;
+    };
+
+    static_assert(std::is_trivially_copyable_v<BridgeValue> && std::is_trivially_destructible_v<BridgeValue>);
+
+    using BridgeValues = std::span<const BridgeValue>;
+
+    // Reads the values from start_index to the top of the stack in one pass. Sequences become arrays, other
+    // tables keep their string, number and boolean keys; functions, userdata and other unsupported values
+    // become nil (and are dropped from tables). A table referenced twice is read once and shared, and a cyclic
+    // one throws. Without nested, tables inside tables read as nil, as the LuaValue adapters drop them anyway,
+    // so a cycle or deep nesting never fails the read.
+    [[nodiscard]] BridgeValues read_bridge_values(lua_State *L, int start_index, BridgeArena &arena,
+                                                  bool nested = true);
+
+    [[nodiscard]] BridgeValue read_bridge_value(lua_State *L, int index, BridgeArena &arena, bool nested = true);
+
+    void push_bridge_value(lua_State *L, const BridgeValue &value);
+
+    void push_bridge_values(lua_State *L, BridgeValues values);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RobloxModLoader/common.hpp"
+#include "environment_template.hpp"
 #include "globals_registry.hpp"
 #include "rml_provider.hpp"
 #include "require_provider.hpp"
@@ -32,7 +33,8 @@ namespace rml::luau::environment {
 
         const auto old_top = lua_gettop(L);
 
-        const bool success = register_all_globals(L);
+        // Registers the providers once per global state and sandboxes L over them
+        const bool success = EnvironmentTemplate::install(L);
         if (success) {
             LOG_DEBUG("Lua environment setup completed successfully");
         } else {
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+
+namespace rml::luau::environment {
+    // Provider globals are registered once per global state, into a read-only template table kept in that
+    // state's registry (so it dies with the state). The template falls back to the state's own globals, and a
+    // sandboxed thread gets an empty env whose shared metatable indexes the template: creating one costs a
+    // single table, however many globals are registered. Globals a thread assigns stay in its own env.
+    class EnvironmentTemplate final {
+    public:
+        // Builds the template on first use for L's global state, then sandboxes L over it
+        static bool install(lua_State *L) noexcept;
+
+        // Gives L a fresh env over the template; luaL_sandboxthread if the state has no template yet
+        static void sandbox_thread(lua_State *L) noexcept;
+
+        [[nodiscard]] static bool exists(lua_State *L) noexcept;
+
+    private:
+        static bool build(lua_State *L) noexcept;
+
+        static void freeze(lua_State *L, int index, int depth) noexcept;
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+#include <unordered_map>
+#include <variant>
+
+namespace rml::luau::environment {
+    class LuaTable {
+    public:
+        LuaTable() = default;
+
+        template<typename T>
+        T get(const std::string &key, const T &default_value = T{}) const {
+            auto it = data_.find(key);
+            if (it == data_.end()) {
+                return default_value;
+            }
+
+            if constexpr (std::is_same_v<T, std::string>) {
+                if (const auto *str_val = std::get_if<std::string>(&it->second)) {
+                    return *str_val;
+                }
+            } else if constexpr (std::is_same_v<T, double>) {
+                if (const auto *num_val = std::get_if<double>(&it->second)) {
+                    return *num_val;
+                }
+            } else if constexpr (std::is_same_v<T, bool>) {
+                if (const auto *bool_val = std::get_if<bool>(&it->second)) {
+                    return *bool_val;
+                }
+            }
+
+            return default_value;
+        }
+
+        bool has_key(const std::string &key) const {
+            return data_.find(key) != data_.end();
+        }
+
+        void set(const std::string &key, const std::variant<std::string, double, bool, std::nullptr_t> &value) {
+            data_[key] = value;
+        }
+
+        size_t size() const { return data_.size(); }
+        bool empty() const { return data_.empty(); }
+
+        auto begin() const { return data_.begin(); }
+        auto end() const { return data_.end(); }
+
+    private:
+        std::unordered_map<std::string, std::variant<std::string, double, bool, std::nullptr_t> > data_;
+    };
+
+    using LuaValue = std::variant<std::string, double, bool, std::nullptr_t, LuaTable>;
+    using LuaParameters = std::vector<LuaValue>;
+}
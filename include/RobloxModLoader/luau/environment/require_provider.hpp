@@ -1,6 +1,7 @@
 #pragma once
 
 #include "globals_registry.hpp"
+#include "RobloxModLoader/luau/bytecode_cache.hpp"
 #include <unordered_map>
 #include <string>
 
@@ -22,21 +23,107 @@ namespace rml::luau::environment {
 
         static std::string resolve_self_path(const std::string &module_name, lua_State *L);
 
+        // Adds the calling chunk -> resolved_path edge to the module graph
+        static void record_dependency(lua_State *L, const std::string &resolved_path);
+
+        // Path of the calling mod from _RML_MOD_CONTEXT, empty outside a mod
+        static std::filesystem::path get_mod_path(lua_State *L);
+
         static std::string normalize_path(const std::string &path);
 
         static bool file_exists(const std::string &path);
 
+        // Write time of a module file, or of the package holding it
+        static std::filesystem::file_time_type module_write_time(const std::string &path);
+
         static std::string read_file_contents(const std::string &path);
     };
 
     namespace require_impl {
+        // Compiled module shared by every lua_State. Published entries are never mutated, only replaced.
+        struct SharedModule {
+            std::string resolved_path;
+            BytecodeCache::Bytecode bytecode;
+            std::filesystem::file_time_type write_time;
+        };
+
+        // Process-wide resolved path -> bytecode store, split into shards so concurrent requires from
+        // different mod threads rarely touch the same lock.
+        class SharedModuleStore final {
+        public:
+            static constexpr std::size_t SHARD_COUNT = 16;
+
+            [[nodiscard]] std::shared_ptr<const SharedModule> find(const std::string &resolved_path) const;
+
+            // Returns the module now stored for its path
+            std::shared_ptr<const SharedModule> publish(std::shared_ptr<const SharedModule> module);
+
+            void invalidate(const std::string &resolved_path);
+
+            void clear();
+
+            // Bumped whenever a published module is dropped or replaced, so states can cheaply tell whether
+            // their cached values may be stale
+            [[nodiscard]] std::uint64_t epoch() const noexcept {
+                return m_epoch.load(std::memory_order_acquire);
+            }
+
+        private:
+            struct alignas(64) Shard {
+                mutable std::shared_mutex mutex;
+                std::unordered_map<std::string, std::shared_ptr<const SharedModule> > modules;
+            };
+
+            [[nodiscard]] Shard &shard_for(const std::string &resolved_path) const noexcept {
+                return m_shards[std::hash<std::string>{}(resolved_path) % SHARD_COUNT];
+            }
+
+            mutable std::array<Shard, SHARD_COUNT> m_shards;
+            std::atomic<std::uint64_t> m_epoch{0};
+        };
+
+        inline SharedModuleStore g_module_store;
+
+        // Which files require which modules, recorded as modules are loaded. Paths are normalized so they
+        // compare equal to what the file watcher reports.
+        class ModuleGraph final {
+        public:
+            void record(const std::string &requirer, const std::string &dependency);
+
+            // The changed files plus every file that requires one of them, directly or through other modules
+            [[nodiscard]] std::unordered_set<std::string> affected_by(
+                const std::vector<std::filesystem::path> &changed) const;
+
+            void clear();
+
+            [[nodiscard]] static std::string normalize(const std::filesystem::path &path);
+
+        private:
+            mutable std::shared_mutex m_mutex;
+            std::unordered_map<std::string, std::unordered_set<std::string> > m_dependents;
+        };
+
+        inline ModuleGraph g_module_graph;
+
+        // Module value this state has executed, with the shared module it came from
+        struct CachedModule {
+            int ref = LUA_NOREF;
+            std::shared_ptr<const SharedModule> module;
+            std::uint64_t epoch{0}; // Store epoch the module was last known current at
+        };
+
+        // Per-state half of the cache: only the registry refs of module values this state has executed
         struct StateCache {
-            std::unordered_map<std::string, int> module_cache;
+            std::unordered_map<std::string, CachedModule> module_cache;
             int original_require_ref = LUA_NOREF;
         };
 
-        inline std::unordered_map<lua_State *, StateCache> g_state_caches;
-        inline std::mutex g_cache_mutex;
+        struct alignas(64) StateCacheShard {
+            std::mutex mutex;
+            std::unordered_map<lua_State *, StateCache> caches;
+        };
+
+        inline std::array<StateCacheShard, SharedModuleStore::SHARD_COUNT> g_state_cache_shards;
 
         StateCache &get_cache_for_state(lua_State *L);
 
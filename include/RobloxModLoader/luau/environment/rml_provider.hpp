@@ -15,6 +15,7 @@ namespace rml::luau::environment {
             std::string mod_author;
             std::filesystem::path mod_path;
             std::vector<std::string> mod_dependencies;
+            std::int32_t mod_priority = 0;
             lua_State *mod_thread = nullptr;
         };
 
@@ -28,6 +29,10 @@ namespace rml::luau::environment {
 
         static void register_utilities_table(lua_State *L) noexcept;
 
+        static void register_scheduler_table(lua_State *L) noexcept;
+
+        static void register_profiler_table(lua_State *L) noexcept;
+
     private:
         static void register_core_namespace(lua_State *L) noexcept;
     };
@@ -61,4 +66,26 @@ namespace rml::luau::environment {
 
         int get_timestamp(lua_State *L);
     }
+
+    namespace rml_scheduler_impl {
+        int get_stats(lua_State *L);
+
+        int verify_preemption(lua_State *L);
+    }
+
+    namespace rml_profiler_impl {
+        int start(lua_State *L);
+
+        int stop(lua_State *L);
+
+        int reset(lua_State *L);
+
+        int is_running(lua_State *L);
+
+        int get_stats(lua_State *L);
+
+        int dump(lua_State *L);
+
+        int save(lua_State *L);
+    }
 }
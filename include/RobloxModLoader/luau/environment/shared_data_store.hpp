@@ -0,0 +1,90 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+#include "lua_value.hpp"
+
+namespace rml::luau::environment {
+    struct SharedDataSnapshot {
+        std::shared_ptr<const LuaValue> value; // Never null; nil for keys that were never set
+        std::uint64_t version{0}; // Bumped on every write to the key; 0 if it was never set
+    };
+
+    using SharedDataCallback = std::function<void(std::string_view key, const SharedDataSnapshot &snapshot)>;
+
+    // Key/value store shared between mods. Keys are spread over SHARD_COUNT independently locked shards, and
+    // values are immutable once stored, so a read only copies a shared_ptr. Writes mark their key dirty;
+    // dispatch_changes() then tells subscribers about each dirty key once, with its latest snapshot.
+    class SharedDataStore final {
+    public:
+        static constexpr std::size_t SHARD_COUNT = 16;
+
+        SharedDataStore();
+
+        SharedDataStore(const SharedDataStore &) = delete;
+
+        SharedDataStore &operator=(const SharedDataStore &) = delete;
+
+        SharedDataStore(SharedDataStore &&) = delete;
+
+        SharedDataStore &operator=(SharedDataStore &&) = delete;
+
+        // Returns the key's new version
+        std::uint64_t set(std::string_view key, LuaValue value);
+
+        [[nodiscard]] SharedDataSnapshot get(std::string_view key) const;
+
+        [[nodiscard]] std::uint64_t version(std::string_view key) const;
+
+        // An empty key subscribes to every key
+        std::size_t subscribe(std::string_view key, SharedDataCallback callback);
+
+        void unsubscribe(std::size_t id);
+
+        [[nodiscard]] bool has_pending_changes() const noexcept {
+            return m_has_changes.load(std::memory_order_acquire);
+        }
+
+        // Calls the subscribers of every key written since the last dispatch; returns how many keys changed
+        std::size_t dispatch_changes() noexcept;
+
+    private:
+        struct NameHash {
+            using is_transparent = void;
+
+            std::size_t operator()(const std::string_view name) const noexcept {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        struct Entry {
+            std::shared_ptr<const LuaValue> value;
+            std::uint64_t version{0};
+        };
+
+        struct alignas(64) Shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<std::string, Entry, NameHash, std::equal_to<> > entries;
+        };
+
+        struct Subscription {
+            std::size_t id;
+            SharedDataCallback callback;
+        };
+
+        // Copy-on-write like the bridge's event listeners; "" holds the subscribers to every key
+        using SubscriptionMap = std::unordered_map<std::string, std::vector<Subscription>, NameHash, std::equal_to<> >;
+
+        [[nodiscard]] Shard &shard_for(std::string_view key) const noexcept;
+
+        std::unique_ptr<Shard[]> m_shards;
+        std::shared_ptr<const LuaValue> m_nil;
+
+        std::mutex m_dirty_mutex;
+        std::unordered_set<std::string, NameHash, std::equal_to<> > m_dirty;
+        std::atomic<bool> m_has_changes{false};
+
+        std::mutex m_subscriptions_mutex;
+        std::atomic<std::shared_ptr<const SubscriptionMap> > m_subscriptions;
+        std::atomic<std::size_t> m_next_subscription_id{1};
+    };
+}
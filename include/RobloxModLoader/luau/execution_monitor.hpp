@@ -0,0 +1,100 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+
+namespace rml::luau {
+    // Limits and usage of one mod. Luau memory is attributed through a memory category of the mod's own. Owned by
+    // the scheduler of the mod's state and never freed while it lives, so raw pointers to it stay valid.
+    struct ModResourceAccount {
+        std::string mod_name;
+        std::uint8_t category{0}; // 0 when none was left, leaving the mod's memory unaccounted
+        std::atomic<std::size_t> memory_limit{0}; // Bytes; 0 is unlimited
+        std::atomic<std::size_t> live_bytes{0};
+        std::atomic<std::size_t> peak_bytes{0};
+        std::atomic<std::size_t> limit_hits{0};
+        std::atomic<bool> over_limit{false}; // Still over after a full collection; cleared once back under
+        std::atomic<bool> collected{false}; // A full collection already ran for the current overrun
+        std::atomic<std::chrono::milliseconds::rep> execution_limit{0}; // Per run; 0 leaves only the context timeout
+        std::atomic<std::size_t> overruns{0}; // Runs preempted for going past their deadline
+    };
+
+    // Owns the Luau interrupt callback of each global state our scripts run on. The callback that was set before
+    // (Roblox's own) keeps being called after ours.
+    class ExecutionMonitor final {
+    public:
+        using InterruptCallback = void (*)(lua_State *L, int gc);
+
+        // Interrupts between deadline and memory checks, so the common path is a counter bump; a power of two
+        static constexpr std::uint32_t LIMIT_CHECK_INTERVAL = 64;
+
+        // Names the mod whose Luau code runs on this OS thread until the scope ends, and when it has to stop. The
+        // scheduler opens one around every lua_resume; scopes nest.
+        class Scope final {
+        public:
+            // A zero time_limit leaves the run without a deadline
+            explicit Scope(std::string_view mod_name, ModResourceAccount *account = nullptr,
+                           std::chrono::milliseconds time_limit = std::chrono::milliseconds{0}) noexcept;
+
+            ~Scope() noexcept;
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+            Scope(Scope &&) = delete;
+
+            Scope &operator=(Scope &&) = delete;
+
+            [[nodiscard]] std::string_view mod_name() const noexcept {
+                return m_mod_name;
+            }
+
+            [[nodiscard]] ModResourceAccount *account() const noexcept {
+                return m_account;
+            }
+
+            [[nodiscard]] std::chrono::milliseconds time_limit() const noexcept {
+                return m_time_limit;
+            }
+
+        private:
+            friend class ExecutionMonitor;
+
+            std::string_view m_mod_name;
+            ModResourceAccount *m_account;
+            std::chrono::milliseconds m_time_limit;
+            std::chrono::steady_clock::time_point m_deadline;
+            bool m_overran{false};
+            Scope *m_previous;
+        };
+
+        // Safe to call more than once per state
+        static void install(lua_State *L) noexcept;
+
+        // Attributes code that allocates in the account's memory category to its mod even outside a scope: the
+        // profiler names the mod and its memory limit applies. The account must outlive L's state.
+        static void register_account(lua_State *L, ModResourceAccount &account) noexcept;
+
+        // Runs a loop that never yields on a new thread of L under a short deadline and logs an error if it runs
+        // to completion instead of being preempted. Returns whether it was; call once install() has run on L.
+        // A diagnostic only (rml.scheduler.verify_preemption): it blocks the calling thread for up to 100 ms.
+        static bool verify_preemption(lua_State *L) noexcept;
+
+        // Innermost scope on this thread, or nullptr outside scheduled mod code
+        [[nodiscard]] static const Scope *current() noexcept;
+
+        // Refreshes live and peak bytes from L's state; returns false while the account stays over its limit
+        static bool refresh_memory(lua_State *L, ModResourceAccount &account) noexcept;
+
+    private:
+        static void interrupt(lua_State *L, int gc);
+
+        // Raises a Luau error in L once the scope is past its deadline
+        static void enforce_deadline(lua_State *L, Scope &scope);
+
+        // Collects once per overrun, then raises a Luau error in L if the mod is still over its limit
+        static void enforce_memory_limit(lua_State *L, ModResourceAccount &account);
+
+        [[nodiscard]] static InterruptCallback previous_interrupt(lua_State *L) noexcept;
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+
+namespace rml::luau {
+    // Watches directory trees for changes to scripts, packages and mod.toml files. A change notification from
+    // the OS (or a poll when notifications aren't available) triggers a rescan; the differences are collected
+    // until the tree has been quiet for the debounce interval, then reported as one batch on the watcher thread.
+    class FileWatcher final {
+    public:
+        enum class ChangeKind : std::uint8_t {
+            Added,
+            Modified,
+            Removed
+        };
+
+        struct Change {
+            std::filesystem::path path;
+            ChangeKind kind;
+        };
+
+        struct Options {
+            std::chrono::milliseconds debounce{250};
+            std::chrono::milliseconds poll_interval{1000}; // Only used without OS notifications
+        };
+
+        using Callback = std::function<void(const std::vector<Change> &)>;
+
+        FileWatcher(std::vector<std::filesystem::path> roots, Callback callback, Options options);
+
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        FileWatcher(FileWatcher &&) = delete;
+
+        FileWatcher &operator=(FileWatcher &&) = delete;
+
+        [[nodiscard]] static bool is_watched_file(const std::filesystem::path &path);
+
+    private:
+        struct FileState {
+            std::filesystem::file_time_type write_time;
+            std::uintmax_t size{0};
+
+            [[nodiscard]] bool operator==(const FileState &) const noexcept = default;
+        };
+
+        using Snapshot = std::unordered_map<std::filesystem::path, FileState>;
+
+        [[nodiscard]] Snapshot scan() const;
+
+        static void diff(const Snapshot &before, const Snapshot &after,
+                         std::unordered_map<std::filesystem::path, ChangeKind> &pending);
+
+        void run(const std::stop_token &stop_token);
+
+        std::vector<std::filesystem::path> m_roots;
+        Callback m_callback;
+        Options m_options;
+        std::jthread m_thread; // Last, so it starts after everything it reads is initialized
+    };
+}
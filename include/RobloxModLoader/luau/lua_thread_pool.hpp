@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+
+namespace rml::luau {
+    // Recycles the short-lived threads a mod runs its scripts and callbacks on. Threads are children of the
+    // mod thread, so they share its sandboxed globals and identity. A leased thread is reclaimed once it has
+    // finished (or errored): its stack is reset and it goes back on the idle list, up to max_idle threads.
+    // Threads that yield and are finished by Roblox's scheduler keep their results on the stack; those count as
+    // finished too once they no longer hold just the chunk they were loaded with (see mark_loaded).
+    //
+    // Only used from the game thread. Threads are anchored in the registry; clear() drops those references
+    // while the Lua state is alive. Destroying the pool never touches Lua, since the state may already be gone.
+    class LuaThreadPool final {
+    public:
+        struct Statistics {
+            std::size_t acquired{0};
+            std::size_t reused{0}; // Acquires served from the idle list
+            std::size_t created{0};
+            std::size_t recycled{0}; // Finished threads reset and kept
+            std::size_t discarded{0}; // Finished threads released because the idle list was full
+            std::size_t finished_with_results{0}; // Reclaimed with return values still on the stack
+            std::size_t idle{0};
+            std::size_t leased{0};
+
+            [[nodiscard]] double hit_rate() const noexcept {
+                return acquired ? static_cast<double>(reused) / static_cast<double>(acquired) : 0.0;
+            }
+        };
+
+        LuaThreadPool(lua_State *parent, std::size_t max_idle) noexcept;
+
+        LuaThreadPool(const LuaThreadPool &) = delete;
+
+        LuaThreadPool &operator=(const LuaThreadPool &) = delete;
+
+        LuaThreadPool(LuaThreadPool &&) = delete;
+
+        LuaThreadPool &operator=(LuaThreadPool &&) = delete;
+
+        // Returns an empty thread with nothing on its stack, or nullptr if one couldn't be created
+        [[nodiscard]] lua_State *acquire() noexcept;
+
+        // Moves finished leased threads back to the idle list. acquire() does this itself when it runs dry.
+        void reclaim() noexcept;
+
+        // Records the chunk just loaded onto the top of a leased thread's stack. Until it has run, a thread that
+        // holds only that chunk is left alone; without this, a non-empty stack never counts as finished.
+        void mark_loaded(lua_State *thread) noexcept;
+
+        // Takes back a leased thread that never ran, such as one whose script failed to load. What it left on
+        // its stack would otherwise keep it from ever counting as finished.
+        void release(lua_State *thread) noexcept;
+
+        // Drops the references to every thread, idle or leased; running threads are collected once they end
+        void clear() noexcept;
+
+        [[nodiscard]] Statistics get_statistics() const noexcept;
+
+        [[nodiscard]] lua_State *parent() const noexcept {
+            return m_parent;
+        }
+
+    private:
+        struct PooledThread {
+            lua_State *thread{nullptr};
+            int ref{LUA_NOREF};
+            const void *entry{nullptr}; // The loaded chunk, set by mark_loaded
+        };
+
+        [[nodiscard]] bool is_finished(const PooledThread &pooled) const noexcept;
+
+        void reclaim_locked() noexcept;
+
+        // Resets a thread and keeps it idle, or drops it when the idle list is full
+        void recycle_locked(const PooledThread &pooled) noexcept;
+
+        void unref_locked(const PooledThread &pooled) const noexcept;
+
+        lua_State *m_parent;
+        std::size_t m_max_idle;
+
+        mutable std::mutex m_mutex;
+        std::vector<PooledThread> m_idle;
+        std::vector<PooledThread> m_leased;
+        Statistics m_statistics;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace rml::luau {
+    // Dependency graph over mods, solved into waves: every mod in a wave depends only on mods in earlier waves,
+    // so the mods within one wave are independent of each other and the wave count is the critical path.
+    class ModGraph final {
+    public:
+        struct Node {
+            std::string id; // Mod directory name
+            std::string name; // Display name from mod.toml
+            std::int32_t priority{0};
+            std::vector<std::string> dependencies; // Matched against either id or name
+        };
+
+        struct Plan {
+            std::vector<std::vector<std::size_t> > waves; // Node indices, higher priority first within a wave
+            std::vector<std::vector<std::size_t> > dependencies; // Resolved dependency indices per node
+            std::vector<std::size_t> wave_of; // Wave per node, REJECTED for nodes that can't load
+            std::vector<std::string> errors; // Missing dependencies and cycles, one message per rejected mod
+
+            [[nodiscard]] bool is_rejected(const std::size_t node) const noexcept {
+                return wave_of[node] == REJECTED;
+            }
+        };
+
+        static constexpr std::size_t REJECTED = static_cast<std::size_t>(-1);
+
+        // satisfied lists ids/names of mods that are already loaded outside this graph, e.g. when one mod is
+        // reloaded on its own; dependencies on them resolve without an edge.
+        [[nodiscard]] static Plan solve(const std::vector<Node> &nodes,
+                                        const std::unordered_set<std::string> &satisfied = {});
+
+    private:
+        [[nodiscard]] static std::string describe_cycle(const std::vector<Node> &nodes,
+                                                        const std::vector<std::vector<std::size_t> > &dependencies,
+                                                        const std::vector<std::size_t> &remaining_degree,
+                                                        std::size_t start);
+    };
+}
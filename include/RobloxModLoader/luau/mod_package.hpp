@@ -0,0 +1,80 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+#include "mod_package_format.hpp"
+
+namespace rml::luau {
+    // Read-only view of a .rmlpkg file. The whole file is mapped once; lookups binary search the index in
+    // place and stored entries are returned without copying. A mapped file can't be replaced on Windows, so
+    // holders copy out what they need and release the package instead of keeping it for the mod's lifetime.
+    class ModPackage final {
+    public:
+        using Entry = package_format::Entry;
+
+        // A path that points into a package, e.g. "mods/foo.rmlpkg/scripts/main.luau"
+        struct PackagedPath {
+            std::shared_ptr<const ModPackage> package;
+            std::string entry_path; // "scripts/main.luau"
+        };
+
+        ~ModPackage();
+
+        ModPackage(const ModPackage &) = delete;
+
+        ModPackage &operator=(const ModPackage &) = delete;
+
+        ModPackage(ModPackage &&) = delete;
+
+        ModPackage &operator=(ModPackage &&) = delete;
+
+        // Opens through a process-wide table, so every loader path shares one mapping per package. A package
+        // that changed on disk since it was mapped is opened again.
+        [[nodiscard]] static std::expected<std::shared_ptr<const ModPackage>, std::string> open(
+            const std::filesystem::path &path);
+
+        // Splits a path at its .rmlpkg component; nullopt when no component is a package file.
+        [[nodiscard]] static std::optional<PackagedPath> resolve(const std::filesystem::path &path);
+
+        [[nodiscard]] static bool is_package_path(const std::filesystem::path &path) noexcept;
+
+        [[nodiscard]] const Entry *find(std::string_view entry_path,
+                                        package_format::EntryKind kind = package_format::EntryKind::File) const noexcept;
+
+        [[nodiscard]] std::string_view path_of(const Entry &entry) const noexcept;
+
+        // Uncompressed contents, checked against the entry's CRC.
+        [[nodiscard]] std::expected<std::string, std::string> read(const Entry &entry) const;
+
+        [[nodiscard]] std::expected<std::string, std::string> read(std::string_view entry_path) const;
+
+        // Precompiled bytecode for a script, only when it was built with the given options.
+        [[nodiscard]] std::optional<std::string> read_bytecode(std::string_view entry_path,
+                                                               const Luau::CompileOptions &options) const;
+
+        [[nodiscard]] std::string_view manifest() const noexcept;
+
+        [[nodiscard]] std::span<const Entry> entries() const noexcept {
+            return m_entries;
+        }
+
+        [[nodiscard]] const std::filesystem::path &path() const noexcept {
+            return m_path;
+        }
+
+    private:
+        ModPackage() = default;
+
+        [[nodiscard]] static std::expected<std::shared_ptr<ModPackage>, std::string> map(
+            const std::filesystem::path &path);
+
+        [[nodiscard]] std::expected<void, std::string> validate();
+
+        std::filesystem::path m_path;
+        std::filesystem::file_time_type m_write_time;
+        const std::byte *m_view{nullptr};
+        std::size_t m_size{0};
+        const package_format::Header *m_header{nullptr};
+        std::span<const Entry> m_entries;
+        std::string_view m_strings;
+    };
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// On-disk layout of a .rmlpkg mod package. Self-contained so the packer tool can build against it without the
+// rest of the loader.
+//
+//   Header
+//   entry data, each blob stored raw or as a zlib stream
+//   path strings, not terminated
+//   Entry[entry_count], sorted by (kind, case-insensitive path)
+//
+// All integers are little endian. Paths are relative to the mod root with '/' separators, e.g.
+// "scripts/main.luau". The mod's mod.toml is the single Manifest entry and is always stored raw, so the loader
+// can parse it straight from the mapping. Bytecode entries record the compile options and Luau bytecode
+// version they were built with; the loader ignores those that don't match its own compiler.
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace rml::luau::package_format {
+    inline constexpr std::array<char, 8> MAGIC{'R', 'M', 'L', 'P', 'K', 'G', '\r', '\n'};
+    inline constexpr std::uint32_t VERSION = 2;
+    inline constexpr std::string_view EXTENSION = ".rmlpkg";
+    inline constexpr std::string_view MANIFEST_PATH = "mod.toml";
+
+    // Most a zlib stream can expand; caps what a Zlib entry may claim as its uncompressed size
+    inline constexpr std::uint64_t MAX_DEFLATE_RATIO = 1032;
+
+    enum class EntryKind : std::uint8_t {
+        Manifest,
+        File,
+        Bytecode // Precompiled form of the File entry with the same path
+    };
+
+    enum class Compression : std::uint8_t {
+        Stored,
+        Zlib
+    };
+
+    struct Header {
+        std::array<char, 8> magic{MAGIC};
+        std::uint32_t version{VERSION};
+        std::uint32_t entry_count{0};
+        std::uint64_t index_offset{0};
+        std::uint64_t strings_offset{0};
+        std::uint64_t strings_size{0};
+        std::array<std::uint8_t, 8> reserved{};
+    };
+
+    struct Entry {
+        std::uint64_t data_offset{0};
+        std::uint32_t stored_size{0};
+        std::uint32_t size{0}; // Uncompressed
+        std::uint32_t crc32{0}; // Of the uncompressed bytes
+        std::uint32_t path_offset{0}; // Into the string table
+        std::uint16_t path_size{0};
+        EntryKind kind{EntryKind::File};
+        Compression compression{Compression::Stored};
+        // Bytecode entries only: Luau optimization and debug level, and the bytecode version (its first byte)
+        std::uint8_t optimization_level{0};
+        std::uint8_t debug_level{0};
+        std::uint8_t bytecode_version{0};
+        std::uint8_t reserved{0};
+    };
+
+    static_assert(sizeof(Header) == 48);
+    static_assert(sizeof(Entry) == 32);
+
+    [[nodiscard]] constexpr char fold_case(const char c) noexcept {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    // Index order; lookups use the same comparison
+    [[nodiscard]] constexpr int compare_paths(const std::string_view lhs, const std::string_view rhs) noexcept {
+        for (std::size_t i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+            const auto l = static_cast<unsigned char>(fold_case(lhs[i]));
+            const auto r = static_cast<unsigned char>(fold_case(rhs[i]));
+            if (l != r) {
+                return l < r ? -1 : 1;
+            }
+        }
+        return lhs.size() == rhs.size() ? 0 : lhs.size() < rhs.size() ? -1 : 1;
+    }
+}
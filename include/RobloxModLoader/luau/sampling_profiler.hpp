@@ -0,0 +1,163 @@
+#pragma once
+
+#include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/util/mpsc_ring_buffer.hpp"
+
+#include <deque>
+
+namespace rml::luau {
+    // Statistical profiler for mod Luau code. A timer thread bumps a tick every interval, and the next interrupt
+    // on each Luau thread after a tick walks that thread's stack into a lock-free ring buffer. The timer thread
+    // also folds the samples into per-stack counts and a bounded trace, which export as collapsed stacks (for
+    // flamegraph.pl / speedscope) or as a Chrome trace. Time spent in C functions shows up on their Luau caller.
+    //
+    // Frame labels are interned once per OS thread: a frame that thread has sampled before costs a hash lookup
+    // in the interrupt, with no formatting, locking or allocation.
+    class SamplingProfiler final {
+    public:
+        static constexpr std::size_t MAX_STACK_DEPTH = 32;
+        static constexpr std::size_t SAMPLE_QUEUE_CAPACITY = 8192;
+        static constexpr std::size_t MAX_TRACE_SAMPLES = 65536;
+        static constexpr std::size_t MAX_NAMES = 65536; // Labels past this share one "<truncated>" frame
+        static constexpr std::chrono::microseconds DEFAULT_INTERVAL{1000};
+        static constexpr std::chrono::microseconds MIN_INTERVAL{100};
+
+        enum class ExportFormat : std::uint8_t {
+            Collapsed,
+            ChromeTrace
+        };
+
+        struct Statistics {
+            bool running{false};
+            std::chrono::microseconds interval{0};
+            std::uint64_t samples{0};
+            std::uint64_t dropped_samples{0};
+            std::size_t unique_stacks{0};
+        };
+
+        SamplingProfiler(const SamplingProfiler &) = delete;
+
+        SamplingProfiler &operator=(const SamplingProfiler &) = delete;
+
+        SamplingProfiler(SamplingProfiler &&) = delete;
+
+        SamplingProfiler &operator=(SamplingProfiler &&) = delete;
+
+        RML_EXPORT [[nodiscard]] static SamplingProfiler &instance() noexcept;
+
+        // Restarts with the new interval if already running; samples collected so far are kept
+        RML_EXPORT std::expected<void, std::string> start(std::chrono::microseconds interval = DEFAULT_INTERVAL);
+
+        RML_EXPORT void stop() noexcept;
+
+        // Drops everything collected so far, including interned labels
+        RML_EXPORT void reset() noexcept;
+
+        [[nodiscard]] bool is_running() const noexcept {
+            return s_tick.load(std::memory_order_relaxed) != 0;
+        }
+
+        RML_EXPORT [[nodiscard]] Statistics get_statistics() const;
+
+        // One "mod;outer;...;inner count" line per distinct stack
+        RML_EXPORT [[nodiscard]] std::string export_collapsed() const;
+
+        // Trace Event Format JSON; consecutive samples sharing frames become one complete ("X") event
+        RML_EXPORT [[nodiscard]] std::string export_chrome_trace() const;
+
+        RML_EXPORT [[nodiscard]] std::string export_as(ExportFormat format) const;
+
+        // An empty path writes to profiles/ next to the loader, named after the current time
+        RML_EXPORT std::expected<std::filesystem::path, std::string> save(
+            ExportFormat format, const std::filesystem::path &path = {}) const;
+
+        [[nodiscard]] static std::optional<ExportFormat> parse_format(std::string_view name) noexcept;
+
+        // Interrupt fast path: true once per tick per OS thread while running
+        [[nodiscard]] static bool sample_due() noexcept {
+            const auto tick = s_tick.load(std::memory_order_relaxed);
+            if (tick == 0 || tick == t_last_tick) {
+                return false;
+            }
+            t_last_tick = tick;
+            return true;
+        }
+
+        // Records the stack of L; called from the interrupt callback
+        void sample(lua_State *L, std::string_view mod_name) noexcept;
+
+    private:
+        SamplingProfiler();
+
+        ~SamplingProfiler() noexcept;
+
+        struct Sample {
+            std::int64_t timestamp{0}; // Microseconds since m_epoch
+            std::uint32_t generation{0}; // Of the labels its ids refer to; older ones are dropped after a reset
+            std::uint32_t thread_id{0};
+            std::uint32_t mod_id{0};
+            std::uint32_t depth{0};
+            std::array<std::uint32_t, MAX_STACK_DEPTH> frames{}; // "function (chunk:line)" labels, outermost first
+        };
+
+        struct TraceSample {
+            std::int64_t timestamp;
+            std::uint32_t thread_id;
+            std::vector<std::uint32_t> stack; // Mod, then frames outermost first
+        };
+
+        struct StackHash {
+            std::size_t operator()(const std::vector<std::uint32_t> &stack) const noexcept {
+                std::size_t hash = stack.size();
+                for (const auto id: stack) {
+                    hash ^= id + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                }
+                return hash;
+            }
+        };
+
+        struct NameHash {
+            using is_transparent = void;
+
+            std::size_t operator()(const std::string_view name) const noexcept {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        [[nodiscard]] std::uint32_t intern(std::string_view name);
+
+        // Id of a frame label, from this thread's cache when it has seen the frame before. The keys are the
+        // pointers lua_Debug hands out; line is INT_MIN for the mod's own frame and negative for C functions.
+        [[nodiscard]] std::uint32_t intern_frame(std::uint32_t generation, const void *name_key,
+                                                 const void *source_key, int line, std::string_view name,
+                                                 std::string_view source);
+
+        void run(std::stop_token stop_token, std::chrono::microseconds interval);
+
+        void aggregate();
+
+        static inline std::atomic<std::uint32_t> s_tick{0};
+        static inline thread_local std::uint32_t t_last_tick{0};
+
+        std::chrono::steady_clock::time_point m_epoch;
+
+        util::MpscRingBuffer<Sample> m_samples{SAMPLE_QUEUE_CAPACITY};
+        std::atomic<std::uint64_t> m_sample_count{0};
+        std::atomic<std::uint64_t> m_dropped_count{0};
+
+        // Interned mod names and frame labels; ids index m_names. Lock order is m_data_mutex, then m_names_mutex.
+        mutable std::mutex m_names_mutex;
+        std::unordered_map<std::string, std::uint32_t, NameHash, std::equal_to<> > m_name_ids;
+        std::vector<std::string> m_names;
+        std::atomic<std::uint32_t> m_generation{0}; // Bumped by reset() once the labels are cleared
+
+        // Written by aggregate(), read by the exports
+        mutable std::mutex m_data_mutex;
+        std::unordered_map<std::vector<std::uint32_t>, std::uint64_t, StackHash> m_stack_counts;
+        std::deque<TraceSample> m_trace;
+
+        std::mutex m_control_mutex;
+        std::jthread m_worker;
+        std::atomic<std::chrono::microseconds::rep> m_interval{0};
+    };
+}
@@ -5,6 +5,7 @@
 #include "script_scheduler.hpp"
 #include "environment/rml_provider.hpp"
 #include "RobloxModLoader/roblox/security/script_permissions.hpp"
+#include "RobloxModLoader/util/task.hpp"
 
 namespace rml::luau {
     class ScriptEngine final {
@@ -43,6 +44,35 @@ namespace rml::luau {
 
         void shutdown() noexcept;
 
+        // Each execute_* has a _task form returning a coroutine task. The script is loaded before the call
+        // returns; awaiting the task resumes the caller on the scheduler's thread once it has run. The engine
+        // must outlive its tasks. The std::future forms are adapters over the tasks.
+        [[nodiscard]] util::Task<ExecutionResult> execute_script_task(
+            std::string_view source_code,
+            std::string_view chunk_name = "=rml_script",
+            RBX::Security::Permissions security_level = RBX::Security::Permissions::RobloxEngine
+        ) const noexcept;
+
+        [[nodiscard]] util::Task<ExecutionResult> execute_script_with_context_task(
+            std::string_view source_code,
+            std::string_view chunk_name,
+            const environment::RMLProvider::ModContext &mod_context,
+            RBX::Security::Permissions security_level = RBX::Security::Permissions::RobloxEngine
+        ) const noexcept;
+
+        [[nodiscard]] util::Task<ExecutionResult> execute_internal_with_context_task(
+            const std::function<int(lua_State *)> &loader,
+            std::string_view chunk_name,
+            const environment::RMLProvider::ModContext &mod_context,
+            RBX::Security::Permissions security_level
+        ) const noexcept;
+
+        [[nodiscard]] util::Task<ExecutionResult> execute_bytecode_task(
+            std::span<const std::byte> bytecode,
+            std::string_view chunk_name = "=rml_bytecode",
+            RBX::Security::Permissions security_level = RBX::Security::Permissions::RobloxEngine
+        ) const noexcept;
+
         [[nodiscard]] std::future<ExecutionResult> execute_script(
             std::string_view source_code,
             std::string_view chunk_name = "=rml_script",
@@ -69,14 +99,18 @@ namespace rml::luau {
             RBX::Security::Permissions security_level = RBX::Security::Permissions::RobloxEngine
         ) const noexcept;
 
+        // Goes through the shared bytecode cache; mod_path enables its on-disk tier
         [[nodiscard]] static std::expected<std::vector<std::byte>, std::string> compile_script(
-            std::string_view source_code
+            std::string_view source_code,
+            const std::filesystem::path &mod_path = {}
         ) noexcept;
 
         [[nodiscard]] const ScriptContext &get_context() const noexcept;
 
         [[nodiscard]] const ScriptScheduler &get_scheduler() const noexcept;
 
+        [[nodiscard]] ScriptScheduler &get_scheduler() noexcept;
+
         [[nodiscard]] bool is_running() const noexcept;
 
         [[nodiscard]] bool is_destroyed() const noexcept;
@@ -95,10 +129,17 @@ namespace rml::luau {
         [[nodiscard]] Statistics get_statistics() const noexcept;
 
     private:
-        [[nodiscard]] std::future<ExecutionResult> execute_internal(
+        // Loads the chunk on a new context right away; mod_context is optional
+        [[nodiscard]] util::Task<ExecutionResult> execute_internal_task(
             const std::function<int(lua_State *)> &loader,
             std::string_view chunk_name,
+            const environment::RMLProvider::ModContext *mod_context,
             RBX::Security::Permissions security_level
         ) const noexcept;
+
+        [[nodiscard]] util::Task<ExecutionResult> await_execution(
+            std::unique_ptr<ScriptScheduler::ExecutionContext> context,
+            std::chrono::high_resolution_clock::time_point start_time
+        ) const;
     };
 }
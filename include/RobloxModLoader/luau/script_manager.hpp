@@ -8,8 +8,13 @@
 #include <string_view>
 
 #include "pointers.hpp"
+#include "bytecode_cache.hpp"
+#include "file_watcher.hpp"
+#include "lua_thread_pool.hpp"
+#include "mod_package.hpp"
 #include "script_engine.hpp"
 #include "RobloxModLoader/roblox/util/standard_out.hpp"
+#include "RobloxModLoader/util/thread_pool.hpp"
 
 namespace RBX {
     class ScriptContext;
@@ -22,6 +27,10 @@ namespace rml::luau {
         std::string pattern;
         std::filesystem::path full_path;
         std::string content;
+        BytecodeCache::Bytecode bytecode; // Compiled and verified at load time
+        // Set for .rmlpkg mods while they load, full_path then points into it. Released once content and
+        // bytecode are copied out, so the file can be replaced for a hot reload.
+        std::shared_ptr<const ModPackage> package;
 
         std::string mod_name;
         std::string mod_version;
@@ -29,18 +38,43 @@ namespace rml::luau {
         std::string mod_author;
         std::filesystem::path mod_path;
         std::vector<std::string> mod_dependencies;
+        std::int32_t mod_priority{0};
     };
 
     struct ModScriptContext {
         std::string mod_name;
-        std::filesystem::path mod_path;
+        std::filesystem::path mod_path; // Mod directory or .rmlpkg file
+        bool is_package{false};
         std::unordered_map<RBX::DataModelType, std::vector<ScriptInfo> > scripts_by_context;
         lua_State *mod_thread{nullptr};
+        std::weak_ptr<ScriptEngine> engine; // Owner of mod_thread's state
+        std::unique_ptr<LuaThreadPool> thread_pool; // Script threads, children of mod_thread
         bool loaded{false};
+        std::size_t load_wave{0}; // Position in the dependency order; mods in one wave don't depend on each other
+        std::vector<std::string> dependencies; // Ids or names of other mods, from mod.toml
+        std::size_t memory_limit{0}; // Bytes of Luau memory across the mod's threads; 0 is unlimited
+        std::chrono::milliseconds execution_limit{0}; // Per run before preemption; 0 leaves the context timeout
     };
 
     class ScriptManager final {
     public:
+        // Per-stage timings of the last load. wall is elapsed time for the stage, busy the summed time of its
+        // tasks across workers.
+        struct LoadTimings {
+            struct Stage {
+                std::chrono::nanoseconds wall{0};
+                std::chrono::nanoseconds busy{0};
+                std::size_t items{0};
+            };
+
+            Stage discover;
+            Stage read;
+            Stage compile;
+            Stage verify;
+            std::chrono::nanoseconds total{0};
+            std::size_t bytes_read{0};
+        };
+
         ScriptManager();
 
         ~ScriptManager();
@@ -62,8 +96,17 @@ namespace rml::luau {
         void load_mod_scripts_for_context(const std::filesystem::path &mod_directory,
                                           const config::ModConfig &mod_config);
 
+        // Schedules the first dependency wave; later waves are released by advance_script_waves once every
+        // script of the previous wave has run.
         void execute_scripts_for_context(RBX::DataModelType data_model_type);
 
+        // Called every frame from the game thread.
+        void advance_script_waves(RBX::DataModelType data_model_type);
+
+        [[nodiscard]] bool has_pending_script_waves() const noexcept {
+            return m_pending_rollouts.load(std::memory_order_acquire) != 0;
+        }
+
         [[nodiscard]] const std::vector<ModScriptContext> &get_loaded_mods() const noexcept {
             return m_loaded_mods;
         }
@@ -74,54 +117,147 @@ namespace rml::luau {
             return m_hot_reload_enabled;
         }
 
-        void set_hot_reload_enabled(const bool enabled) noexcept {
-            m_hot_reload_enabled = enabled;
+        // Starts or stops watching the mods directory once mods have been loaded from it
+        void set_hot_reload_enabled(bool enabled) noexcept;
+
+        // Called every frame from the game thread. Swaps in scripts recompiled by the file watcher and restarts
+        // the running mods they belong to, and reloads mods whose files were added, removed or reconfigured.
+        void process_hot_reloads();
+
+        [[nodiscard]] bool has_pending_hot_reloads() const noexcept {
+            return m_hot_reload_pending.load(std::memory_order_acquire);
         }
 
+        [[nodiscard]] LoadTimings get_last_load_timings() const;
+
+        struct ModThreadPoolStatistics {
+            std::string mod_name;
+            LuaThreadPool::Statistics statistics;
+        };
+
+        [[nodiscard]] std::vector<ModThreadPoolStatistics> get_thread_pool_statistics() const;
+
     private:
+        struct ModLoadRequest {
+            std::filesystem::path mod_directory;
+            std::optional<config::ModConfig> mod_config; // Read from mod.toml during discovery when empty
+        };
+
+        // Wave by wave execution of one DataModel's scripts
+        struct ScriptRollout {
+            std::size_t next_wave{0};
+            std::shared_ptr<std::atomic<std::size_t> > in_flight; // Scripts of the current wave still running
+        };
+
         mutable std::shared_mutex m_scripts_mutex;
-        std::vector<ModScriptContext> m_loaded_mods;
+        std::vector<ModScriptContext> m_loaded_mods; // Dependency order
+        std::unordered_map<RBX::DataModelType, ScriptRollout> m_rollouts; // Guarded by m_scripts_mutex
+        std::atomic<std::size_t> m_pending_rollouts{0};
         std::atomic<bool> m_hot_reload_enabled{false};
 
-        [[nodiscard]] static std::vector<ScriptInfo> resolve_script_patterns(
-            const std::filesystem::path &scripts_directory,
-            const std::vector<std::string> &patterns,
-            const config::ModConfig &mod_config);
+        std::unique_ptr<util::ThreadPool> m_worker_pool;
+        mutable std::mutex m_load_timings_mutex;
+        LoadTimings m_last_load_timings;
+
+        // Script recompiled off the game thread, waiting to replace the loaded copy
+        struct StagedScript {
+            std::filesystem::path full_path;
+            std::string content;
+            BytecodeCache::Bytecode bytecode;
+        };
+
+        std::filesystem::path m_mods_directory;
+        std::mutex m_file_watcher_mutex;
+        std::unique_ptr<FileWatcher> m_file_watcher;
+
+        std::mutex m_hot_reload_mutex;
+        std::vector<StagedScript> m_staged_scripts;
+        std::unordered_set<std::filesystem::path> m_pending_mod_reloads; // Mod directories and packages
+        std::atomic<bool> m_hot_reload_pending{false};
+
+        void start_file_watcher();
+
+        void stop_file_watcher();
+
+        // Runs on the watcher thread
+        void on_files_changed(const std::vector<FileWatcher::Change> &changes);
+
+        // Unloads the mod at mod_path and loads it again from disk, re-reading its mod.toml
+        void reload_mod_from_disk(const std::filesystem::path &mod_path);
+
+        // Requires m_scripts_mutex held exclusively. Places a mod loaded on its own one wave after the latest of
+        // the loaded mods it depends on and runs it, now or as part of a rollout still working towards that wave.
+        void schedule_reloaded_mod(ModScriptContext &mod_context);
+
+        // Discover, read, compile and verify on the worker pool; the game thread only luau_loads the result.
+        // already_loaded holds ids and names of mods outside this load that satisfy dependencies.
+        [[nodiscard]] std::vector<ModScriptContext> run_load_pipeline(
+            std::vector<ModLoadRequest> requests,
+            const std::unordered_set<std::string> &already_loaded = {});
+
+        // Requires m_scripts_mutex held exclusively. Returns false once no wave is left to schedule.
+        bool schedule_next_wave(RBX::DataModelType data_model_type, ScriptRollout &rollout);
+
+        // Requires m_scripts_mutex held exclusively. Creates the mod thread on first use; returns the number of
+        // scripts handed to the engine.
+        static std::size_t schedule_mod_scripts(ModScriptContext &mod_context, RBX::DataModelType data_model_type,
+                                                const std::shared_ptr<std::atomic<std::size_t> > &in_flight);
+
+        [[nodiscard]] static std::optional<ModScriptContext> discover_mod_scripts(
+            const std::filesystem::path &mod_directory,
+            const config::ModConfig &mod_config,
+            const std::shared_ptr<const ModPackage> &package = nullptr);
+
+        struct ScriptFileEntry {
+            std::filesystem::path full_path;
+            std::string relative_path; // '/' separated, what patterns are matched against
+        };
+
+        [[nodiscard]] static ScriptInfo make_script_info(const std::string &pattern,
+                                                         const std::filesystem::path &file_path,
+                                                         const config::ModConfig &mod_config,
+                                                         const std::filesystem::path &mod_path);
 
         [[nodiscard]] static std::string load_script_content(const std::filesystem::path &script_path);
 
-        [[nodiscard]] static bool matches_pattern(const std::filesystem::path &file_path,
-                                                  const std::string &pattern);
+        // Every .lua/.luau file under directory from one recursive walk, sorted by relative path.
+        [[nodiscard]] static std::vector<ScriptFileEntry> list_script_files(const std::filesystem::path &directory);
 
-        [[nodiscard]] static std::vector<std::filesystem::path> find_matching_files(
-            const std::filesystem::path &directory,
-            const std::vector<std::string> &patterns);
+        // Same for the scripts/ entries of a package, with full paths under package_path.
+        [[nodiscard]] static std::vector<ScriptFileEntry> list_package_script_files(
+            const ModPackage &package,
+            const std::filesystem::path &package_path);
 
         [[nodiscard]] static lua_State *create_mod_thread(RBX::DataModelType data_model_type,
-                                                          const std::string &mod_name) noexcept;
+                                                          const std::string &mod_name,
+                                                          std::size_t memory_limit,
+                                                          std::chrono::milliseconds execution_limit) noexcept;
 
         static void cleanup_mod_thread(ModScriptContext &mod_context) noexcept;
 
-        [[nodiscard]] static std::future<ScriptEngine::ExecutionResult> execute_script_in_mod_thread(
+        [[nodiscard]] static util::Task<ScriptEngine::ExecutionResult> execute_script_in_mod_thread(
             const std::shared_ptr<ScriptEngine> &engine,
             const ScriptInfo &script_info,
             const std::string &chunk_name,
-            lua_State *mod_thread) noexcept;
+            LuaThreadPool &thread_pool) noexcept;
 
         static void schedule_script(RBX::DataModelType data_model_type, const ScriptInfo &script_info);
 
-        static void schedule_script_with_mod_thread(RBX::DataModelType data_model_type,
+        // Returns whether the script was handed to the engine; in_flight is decremented once it has run.
+        static bool schedule_script_with_mod_thread(RBX::DataModelType data_model_type,
                                                     const ScriptInfo &script_info,
-                                                    lua_State *mod_thread);
+                                                    LuaThreadPool *thread_pool,
+                                                    const std::shared_ptr<std::atomic<std::size_t> > &in_flight = nullptr);
 
         static void execute_script_async(const std::shared_ptr<class ScriptEngine> &engine,
                                          const ScriptInfo &script_info,
                                          const std::string &chunk_name) noexcept;
 
-        static void execute_script_async_with_mod_thread(const std::shared_ptr<class ScriptEngine> &engine,
+        static bool execute_script_async_with_mod_thread(const std::shared_ptr<class ScriptEngine> &engine,
                                                          const ScriptInfo &script_info,
                                                          const std::string &chunk_name,
-                                                         lua_State *mod_thread) noexcept;
+                                                         LuaThreadPool *thread_pool,
+                                                         std::shared_ptr<std::atomic<std::size_t> > in_flight) noexcept;
 
         template<typename ResultType>
         static void handle_script_result(const ScriptInfo &script_info,
@@ -1,6 +1,12 @@
 #pragma once
 
 #include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/luau/execution_monitor.hpp"
+#include "RobloxModLoader/util/log_linear_histogram.hpp"
+#include "RobloxModLoader/util/mpsc_ring_buffer.hpp"
+
+#include <coroutine>
+#include <deque>
 
 namespace RBX::Security {
     enum class Permissions : std::uint32_t;
@@ -18,28 +24,145 @@ namespace rml::luau {
         };
 
         struct ExecutionContext {
+            // Allocation-free completion for awaited executions. Lives in the awaiting coroutine's frame; the
+            // scheduler fills it in and resumes the coroutine from its consumer thread.
+            struct Completion {
+                std::coroutine_handle<> continuation;
+                Completion *next{nullptr}; // Intrusive link while waiting to be resumed
+                std::string error;
+                bool failed{false};
+            };
+
+            static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{5000};
+
             lua_State *L{nullptr};
             lua_State *rL{nullptr};
             std::string chunk_name;
             RBX::Security::Permissions security_level{0};
             Priority priority{Priority::Normal};
             std::chrono::steady_clock::time_point scheduled_time;
-            std::chrono::milliseconds timeout{5000};
-            std::promise<void> completion_promise;
+            std::chrono::steady_clock::time_point enqueue_time; // Set by schedule_script
+            std::chrono::milliseconds timeout{DEFAULT_TIMEOUT}; // For the first run; each resume gets DEFAULT_TIMEOUT
+            std::string mod_name;
+            std::uint32_t mod_weight{1};
+            std::optional<std::promise<void> > completion_promise; // Only for schedule_script callers
+            Completion *completion{nullptr}; // Set instead of completion_promise when awaited
             std::atomic<bool> is_cancelled{false};
         };
 
+        // Awaitable returned by schedule(). Completes with an error when the context is rejected, cancelled
+        // or fails to start.
+        class ScheduleAwaiter final {
+        public:
+            ScheduleAwaiter(ScriptScheduler &scheduler, std::unique_ptr<ExecutionContext> context) noexcept
+                : m_scheduler(scheduler)
+                  , m_context(std::move(context)) {
+            }
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+            std::expected<void, std::string> await_resume() noexcept;
+
+        private:
+            ScriptScheduler &m_scheduler;
+            std::unique_ptr<ExecutionContext> m_context;
+            ExecutionContext::Completion m_completion;
+        };
+
+        // Latency histograms for one (mod, chunk) pair. Never freed while the scheduler lives, so raw pointers
+        // to it stay valid.
+        struct ScriptTelemetry {
+            std::string mod_name;
+            std::string chunk_name;
+            util::LogLinearHistogram queue_wait;
+            util::LogLinearHistogram run_time;
+            util::LogLinearHistogram resume_time;
+            ModResourceAccount *account{nullptr}; // The mod's, when it has one
+        };
+
         struct YieldedCoroutine {
+            static constexpr std::size_t NO_CONDITION_SLOT = std::numeric_limits<std::size_t>::max();
+
             lua_State *thread{nullptr};
             std::chrono::steady_clock::time_point yield_time;
             std::chrono::milliseconds yield_duration{0};
             std::function<bool()> resume_condition;
             std::any resume_data;
+            std::uint64_t generation{0};
+            std::size_t condition_slot{NO_CONDITION_SLOT};
+            ScriptTelemetry *telemetry{nullptr};
+        };
+
+        // Deadline entry for duration based waits. Entries are never removed eagerly; a timer whose
+        // generation no longer matches the indexed coroutine is stale and skipped when it expires.
+        struct WaitTimer {
+            std::chrono::steady_clock::time_point deadline;
+            std::uint64_t generation{0};
+            lua_State *thread{nullptr};
+
+            [[nodiscard]] bool operator>(const WaitTimer &other) const noexcept {
+                return deadline > other.deadline;
+            }
+        };
+
+        // Context scheduled for the future. Kept in a heap ordered by due time (FIFO on ties) and only
+        // moved into the ready queues once due.
+        struct DelayedContext {
+            std::chrono::steady_clock::time_point due;
+            std::uint64_t sequence{0};
+            std::unique_ptr<ExecutionContext> context;
+
+            [[nodiscard]] bool operator>(const DelayedContext &other) const noexcept {
+                return due != other.due ? due > other.due : sequence > other.sequence;
+            }
+        };
+
+        struct ModBudgetUsage {
+            std::string mod_name;
+            std::uint32_t weight{1};
+            std::size_t pending_scripts{0};
+            std::size_t executed_scripts{0};
+            std::chrono::nanoseconds total_time{0};
+            std::chrono::nanoseconds last_frame_time{0};
+            std::chrono::nanoseconds deficit{0};
+        };
+
+        // Memory is as of the mod's last run or memory check
+        struct ModResourceUsage {
+            std::string mod_name;
+            std::size_t live_bytes{0};
+            std::size_t peak_bytes{0};
+            std::size_t memory_limit{0}; // 0 is unlimited
+            std::size_t limit_hits{0};
+            bool over_limit{false};
+            std::chrono::milliseconds execution_limit{0}; // 0 leaves only the context timeout
+            std::size_t overruns{0};
+        };
+
+        struct LatencyPercentiles {
+            std::uint64_t samples{0};
+            std::chrono::nanoseconds p50{0};
+            std::chrono::nanoseconds p95{0};
+            std::chrono::nanoseconds p99{0};
+            std::chrono::nanoseconds max{0};
+        };
+
+        struct ScriptLatency {
+            std::string mod_name;
+            std::string chunk_name;
+            LatencyPercentiles queue_wait;
+            LatencyPercentiles run_time;
+            LatencyPercentiles resume_time; // samples is the resume count
         };
 
         struct SchedulerConfig {
             std::size_t max_worker_threads{std::thread::hardware_concurrency()};
-            std::chrono::milliseconds time_slice{10};
+            std::chrono::milliseconds time_slice{10}; // Per-frame budget for step_budgeted()
+            std::chrono::microseconds fair_share_quantum{1000}; // Deficit added per round for a weight 1 mod
             std::chrono::milliseconds idle_sleep{1};
             std::size_t max_queue_size{10000};
             bool enable_load_balancing{true};
@@ -49,19 +172,74 @@ namespace rml::luau {
     private:
         SchedulerConfig m_config;
 
-        std::array<std::queue<std::unique_ptr<ExecutionContext> >, 5> m_execution_queues;
-        std::mutex m_queue_mutex;
-        std::condition_variable m_queue_cv;
+        using ContextQueue = util::MpscRingBuffer<std::unique_ptr<ExecutionContext> >;
+
+        // Producers (any thread) push into the ring buffers; step() is the single consumer. m_queued_count
+        // admits work against max_queue_size and also counts delayed contexts.
+        std::array<ContextQueue, 5> m_execution_queues;
+        ContextQueue m_delayed_inbox;
+        std::atomic<std::size_t> m_queued_count{0};
+        std::size_t m_queue_capacity{0};
+
+        // Consumer-owned; only touched while m_consumer_active is held.
+        std::vector<DelayedContext> m_delayed_scripts;
+        std::uint64_t m_next_delay_sequence{0};
+        std::atomic<std::size_t> m_delayed_count{0};
+        std::atomic_flag m_consumer_active;
+
+        // Awaited contexts that finished while the consumer was busy; resumed once it lets go of the queues
+        ExecutionContext::Completion *m_completed{nullptr};
+
+        // Per-mod flow for deficit round-robin. Consumer-owned; contexts stay counted in m_queued_count
+        // until they run.
+        struct ModFlow {
+            std::string mod_name;
+            std::uint32_t weight{1};
+            std::deque<std::unique_ptr<ExecutionContext> > pending;
+            std::chrono::nanoseconds deficit{0};
+            std::size_t executed{0};
+            std::chrono::nanoseconds total_time{0};
+            std::chrono::nanoseconds frame_time{0};
+            bool active{false};
+            std::unordered_map<std::string, ScriptTelemetry *> telemetry; // By chunk name
+            ModResourceAccount *account{nullptr};
+        };
 
-        std::vector<YieldedCoroutine> m_yielded_coroutines;
-        std::mutex m_yield_mutex;
+        std::unordered_map<std::string, ModFlow> m_mod_flows;
+        std::deque<ModFlow *> m_active_flows;
+
+        mutable std::mutex m_budget_usage_mutex;
+        std::vector<ModBudgetUsage> m_budget_usage;
+
+        // Telemetry is created on first use under the exclusive lock; the consumer caches the pointers per
+        // flow, so the lock is only taken for new chunks and by readers.
+        mutable std::shared_mutex m_telemetry_mutex;
+        std::unordered_map<std::string, std::unique_ptr<ScriptTelemetry> > m_telemetry;
+        util::LogLinearHistogram m_queue_wait_histogram;
+        util::LogLinearHistogram m_run_time_histogram;
+        util::LogLinearHistogram m_resume_time_histogram;
+
+        // Per-mod limits and usage; memory categories of this scheduler's state are handed out from a range Roblox
+        // doesn't use
+        mutable std::shared_mutex m_resource_mutex;
+        std::unordered_map<std::string, std::unique_ptr<ModResourceAccount> > m_resource_accounts;
+        std::uint32_t m_next_memory_category;
+
+        std::unordered_map<lua_State *, YieldedCoroutine> m_yielded_coroutines;
+        std::priority_queue<WaitTimer, std::vector<WaitTimer>, std::greater<> > m_wait_timers;
+        std::vector<lua_State *> m_condition_waiters;
+        std::vector<YieldedCoroutine> m_ready_coroutines;
+        std::uint64_t m_next_yield_generation{0};
+        // Which script a thread was started for, so its resumes are attributed. Guarded by m_yield_mutex.
+        std::unordered_map<lua_State *, ScriptTelemetry *> m_thread_telemetry;
+        mutable std::mutex m_yield_mutex;
 
         std::atomic<bool> m_is_running{false};
         std::atomic<bool> m_is_shutting_down{false};
 
         std::atomic<std::size_t> m_total_executed{0};
         std::atomic<std::size_t> m_currently_executing{0};
-        std::atomic<std::chrono::nanoseconds> m_total_execution_time;
+        std::atomic<std::chrono::nanoseconds::rep> m_total_execution_time{0};
 
     public:
         explicit ScriptScheduler(const SchedulerConfig &config = {});
@@ -85,6 +263,12 @@ namespace rml::luau {
             std::chrono::milliseconds delay
         ) noexcept;
 
+        // Coroutine counterpart of schedule_script: co_await resumes the caller on the scheduler's thread once
+        // the context has run, without a promise or any other allocation.
+        [[nodiscard]] ScheduleAwaiter schedule(std::unique_ptr<ExecutionContext> context) noexcept {
+            return ScheduleAwaiter(*this, std::move(context));
+        }
+
         int yield_script(
 
             lua_State *L,
@@ -98,25 +282,36 @@ namespace rml::luau {
 
         void cancel_all_scripts() noexcept;
 
+        // Cancels the mod's queued and yielded scripts and frees its per-script telemetry, for a mod being
+        // unloaded. Its resource account is kept, a reload of the same mod picks it up again.
+        void release_mod(const std::string &mod_name) noexcept;
+
         [[nodiscard]] bool is_running() const noexcept;
 
         [[nodiscard]] std::size_t get_total_queue_size() const noexcept;
 
         [[nodiscard]] std::size_t get_executing_script_count() const noexcept;
 
-        [[nodiscard]] std::size_t get_yielded_script_count() noexcept;
+        [[nodiscard]] std::size_t get_yielded_script_count() const noexcept;
 
         struct Statistics {
             std::size_t total_executed{0};
             std::size_t currently_executing{0};
             std::size_t queued_scripts{0};
             std::size_t yielded_scripts{0};
+            std::size_t delayed_scripts{0};
             std::chrono::nanoseconds total_execution_time{0};
             std::chrono::nanoseconds average_execution_time{0};
             std::array<std::size_t, 5> queue_sizes{};
+            std::vector<ModBudgetUsage> mod_budget_usage;
+            std::vector<ModResourceUsage> mod_resources;
+            LatencyPercentiles queue_wait;
+            LatencyPercentiles run_time;
+            LatencyPercentiles resume_time;
+            std::vector<ScriptLatency> script_latency;
         };
 
-        [[nodiscard]] Statistics get_statistics();
+        [[nodiscard]] Statistics get_statistics() const;
 
         void set_config(const SchedulerConfig &config) noexcept;
 
@@ -124,12 +319,69 @@ namespace rml::luau {
 
         bool step() noexcept;
 
+        // Runs ready work until time_slice is spent, sharing it across mods by weighted deficit round-robin.
+        // Returns the number of scripts executed; work left over carries to the next call.
+        std::size_t step_budgeted() noexcept;
+
+        [[nodiscard]] std::vector<ModBudgetUsage> get_mod_budget_usage() const;
+
+        // Tags thread, and every thread later created from it, with the mod's memory category and sets the mod's
+        // limits (0 is unlimited). Once the categories reserved for mods run out, only the time limit applies.
+        ModResourceAccount *attach_mod_resources(lua_State *thread, const std::string &mod_name,
+                                                 std::size_t memory_limit,
+                                                 std::chrono::milliseconds execution_limit) noexcept;
+
+        [[nodiscard]] std::vector<ModResourceUsage> get_mod_resource_usage() const;
+
+        // Maps ModConfig::runtime.priority to a fair-share weight: priority 0 (and below) is weight 1, each
+        // step above adds one share.
+        [[nodiscard]] static std::uint32_t weight_for_priority(std::int32_t priority) noexcept;
+
     private:
         void process_yielded_coroutines() noexcept;
 
-        [[nodiscard]] std::unique_ptr<ExecutionContext> get_next_script() noexcept;
+        void register_yield_locked(YieldedCoroutine yielded);
+
+        [[nodiscard]] YieldedCoroutine take_yield_locked(
+            std::unordered_map<lua_State *, YieldedCoroutine>::iterator it) noexcept;
+
+        bool resume_coroutine(YieldedCoroutine yielded) noexcept;
+
+        std::size_t run_fair(std::chrono::nanoseconds budget, std::size_t max_scripts) noexcept;
+
+        // Requires the consumer scope
+        std::size_t run_flows(std::chrono::nanoseconds budget, std::size_t max_scripts) noexcept;
+
+        // Admits a context into the queues; context is left untouched when it's rejected
+        [[nodiscard]] std::expected<void, std::string> enqueue(std::unique_ptr<ExecutionContext> &context) noexcept;
+
+        // Reports the end of a context, with an error unless it ran. Requires the consumer scope.
+        void complete(ExecutionContext &context, std::string_view error = {}) noexcept;
+
+        // Resumes a list taken from m_completed, after the consumer scope was released
+        static void resume_completed(ExecutionContext::Completion *completed) noexcept;
+
+        void collect_ready_scripts();
+
+        void publish_budget_usage();
+
+        [[nodiscard]] ScriptTelemetry *telemetry_for(ModFlow &flow, const std::string &chunk_name);
+
+        [[nodiscard]] ModResourceAccount *find_resource_account(const std::string &mod_name) const;
+
+        void record_resume(const YieldedCoroutine &yielded, std::chrono::nanoseconds elapsed) noexcept;
+
+        [[nodiscard]] static LatencyPercentiles to_percentiles(const util::LogLinearHistogram &histogram) noexcept;
+
+        void promote_due_scripts(std::chrono::steady_clock::time_point now);
+
+        void drain_delayed_inbox();
+
+        std::size_t cancel_queued_if(const std::function<bool(const ExecutionContext &)> &predicate,
+                                     std::string_view reason) noexcept;
 
-        void execute_script(const std::unique_ptr<ExecutionContext> &context) noexcept;
+        std::chrono::nanoseconds execute_script(const std::unique_ptr<ExecutionContext> &context,
+                                                ModResourceAccount *account) noexcept;
     };
 
     int luau_yield(lua_State *L);
@@ -5,6 +5,8 @@
 #include <memory>
 #include <unordered_map>
 
+#include "RobloxModLoader/util/mpsc_ring_buffer.hpp"
+
 namespace events {
     struct EventBase {
         virtual ~EventBase() = default;
@@ -12,6 +14,44 @@ namespace events {
         bool cancelled = false;
     };
 
+    template<typename T>
+    concept Event = std::derived_from<T, EventBase>;
+
+    // Handlers run from highest to lowest priority, in registration order within a priority
+    enum class EventPriority : int {
+        Lowest = -200,
+        Low = -100,
+        Normal = 0,
+        High = 100,
+        Highest = 200
+    };
+
+    using EventTypeId = std::uint64_t;
+
+    namespace detail {
+        constexpr EventTypeId fnv1a(const std::string_view value) noexcept {
+            EventTypeId hash = 14695981039346656037ull;
+            for (const char c: value) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        // Built from the type's name rather than an address, so the id is the same in the loader and in every
+        // mod DLL that instantiates it
+        template<typename T>
+        constexpr std::string_view type_signature() noexcept {
+#if defined(_MSC_VER)
+            return __FUNCSIG__;
+#else
+            return __PRETTY_FUNCTION__;
+#endif
+        }
+    }
+
+    template<Event T>
+    inline constexpr EventTypeId event_type_id = detail::fnv1a(detail::type_signature<std::remove_cv_t<T> >());
+
     struct AuthenticationEvent final : EventBase {
         uint64_t *thisPtr;
         uint64_t docPanelProvider;
@@ -22,6 +62,16 @@ namespace events {
         }
     };
 
+    // Deferred handlers run later, in batches, from dispatchDeferred() instead of on the emitting thread. They
+    // get a copy of the event made after the immediate handlers ran, and cancelling it only stops the deferred
+    // handlers after them.
+    enum class EventDelivery {
+        Immediate,
+        Deferred
+    };
+
+    // Safe to use from any thread. Handler tables are published copy-on-write: registration copies the table
+    // under a mutex and swaps it in, while emit only loads the current table and never blocks on a writer.
     class EventManager {
     public:
         EventManager();
@@ -30,32 +80,184 @@ namespace events {
         template<typename T>
         using EventHandler = std::function<void(T &)>;
 
-        template<typename T>
-        void registerHandler(EventHandler<T> handler) {
-            auto wrappedHandler = [handler](std::shared_ptr<EventBase> e) {
-                if (auto event = std::dynamic_pointer_cast<T>(e)) {
-                    handler(*event);
+        using HandlerId = std::size_t;
+
+        static constexpr std::size_t DEFERRED_QUEUE_CAPACITY = 1024;
+
+        template<Event T>
+        HandlerId registerHandler(EventHandler<T> handler,
+                                  const EventPriority priority = EventPriority::Normal,
+                                  const EventDelivery delivery = EventDelivery::Immediate) {
+            if (!handler) {
+                return 0;
+            }
+
+            if constexpr (!std::is_copy_constructible_v<T>) {
+                if (delivery == EventDelivery::Deferred) {
+                    LOG_WARN("Deferred handlers need a copyable event type");
+                    return 0;
+                }
+            }
+
+            std::lock_guard lock(write_mutex);
+            const auto id = next_handler_id++;
+
+            const auto table = handlers.load(std::memory_order_acquire);
+            const auto *current = find_handlers<T>(*table);
+            auto list = current ? std::make_shared<HandlerList<T> >(*current) : std::make_shared<HandlerList<T> >();
+
+            // After the handlers already registered at this priority
+            auto &entries = delivery == EventDelivery::Deferred ? list->deferred : list->immediate;
+            const auto position = std::ranges::upper_bound(entries, priority, std::ranges::greater{},
+                                                           &HandlerList<T>::Entry::priority);
+            entries.insert(position, typename HandlerList<T>::Entry{priority, id, std::move(handler)});
+
+            publish(*table, event_type_id<T>, std::move(list));
+            return id;
+        }
+
+        template<Event T>
+        bool unregisterHandler(const HandlerId id) {
+            std::lock_guard lock(write_mutex);
+
+            const auto table = handlers.load(std::memory_order_acquire);
+            const auto *current = find_handlers<T>(*table);
+            if (!current) {
+                return false;
+            }
+
+            auto list = std::make_shared<HandlerList<T> >(*current);
+            const auto matches = [id](const auto &entry) { return entry.id == id; };
+            if (std::erase_if(list->immediate, matches) + std::erase_if(list->deferred, matches) == 0) {
+                return false;
+            }
+
+            publish(*table, event_type_id<T>, list->immediate.empty() && list->deferred.empty()
+                                                  ? nullptr
+                                                  : std::move(list));
+            return true;
+        }
+
+        // Handlers get the caller's event itself, so their changes are visible to the caller and to the
+        // handlers after them. Dispatch stops as soon as a handler cancels the event; returns false if it did.
+        // If the event survives and T has deferred handlers, a copy is queued for them on this thread's queue.
+        template<Event T>
+        bool emit(T &event) {
+            if (event.cancelled) {
+                return false;
+            }
+
+            // Keeps the table, and so the handlers, alive while they run even if they are replaced meanwhile
+            const auto table = handlers.load(std::memory_order_acquire);
+            const auto *list = find_handlers<T>(*table);
+            if (!list) {
+                return true;
+            }
+
+            for (const auto &entry: list->immediate) {
+                entry.handler(event);
+                if (event.cancelled) {
+                    return false;
                 }
+            }
+
+            if constexpr (std::is_copy_constructible_v<T>) {
+                if (!list->deferred.empty()) {
+                    enqueue_deferred(DeferredEvent{std::make_unique<T>(event), &dispatch_deferred<T>});
+                }
+            }
+
+            return true;
+        }
+
+        template<Event T>
+        [[nodiscard]] bool hasHandlers() const {
+            return find_handlers<T>(*handlers.load(std::memory_order_acquire)) != nullptr;
+        }
+
+        // Runs the deferred handlers of up to max_events queued events, oldest first per thread. Only one
+        // thread drains at a time; returns 0 straight away while another one is.
+        RML_EXPORT std::size_t dispatchDeferred(
+            std::size_t max_events = std::numeric_limits<std::size_t>::max()) noexcept;
+
+        [[nodiscard]] bool hasDeferredEvents() const noexcept {
+            return pending_deferred.load(std::memory_order_acquire) > 0;
+        }
+
+    private:
+        struct HandlerListBase {
+            virtual ~HandlerListBase() = default;
+        };
+
+        template<typename T>
+        struct HandlerList final : HandlerListBase {
+            struct Entry {
+                EventPriority priority;
+                HandlerId id;
+                EventHandler<T> handler;
             };
-            handlers[typeid(T).hash_code()].push_back(wrappedHandler);
+
+            std::vector<Entry> immediate;
+            std::vector<Entry> deferred;
+        };
+
+        using HandlerTable = std::unordered_map<EventTypeId, std::shared_ptr<const HandlerListBase> >;
+
+        struct DeferredEvent {
+            std::unique_ptr<EventBase> event;
+            void (*dispatch)(EventManager &manager, EventBase &event);
+        };
+
+        using DeferredQueue = rml::util::MpscRingBuffer<DeferredEvent>;
+
+        template<typename T>
+        static const HandlerList<T> *find_handlers(const HandlerTable &table) noexcept {
+            const auto it = table.find(event_type_id<T>);
+            return it != table.end() ? static_cast<const HandlerList<T> *>(it->second.get()) : nullptr;
         }
 
+        // Handlers are looked up again when the event is drained, so one unregistered since the emit won't run
         template<typename T>
-        void emit(T &event) {
-            auto baseEvent = std::make_shared<T>(event);
-            const auto typeHash = typeid(T).hash_code();
-            if (const auto it = handlers.find(typeHash); it != handlers.end()) {
-                for (const auto &handler: it->second) {
-                    if (!event.cancelled) {
-                        handler(baseEvent);
-                    }
+        static void dispatch_deferred(EventManager &manager, EventBase &base) {
+            auto &event = static_cast<T &>(base);
+
+            const auto table = manager.handlers.load(std::memory_order_acquire);
+            const auto *list = find_handlers<T>(*table);
+            if (!list) {
+                return;
+            }
+
+            for (const auto &entry: list->deferred) {
+                entry.handler(event);
+                if (event.cancelled) {
+                    break;
                 }
             }
         }
 
-    private:
-        using HandlerFunc = std::function<void(std::shared_ptr<EventBase>)>;
-        std::unordered_map<size_t, std::vector<HandlerFunc> > handlers;
+        // publish and enqueue_deferred are exported: the templates above call them from every mod DLL that
+        // instantiates them
+
+        // Replaces (or with a null list, removes) one entry; write_mutex must be held
+        RML_EXPORT void publish(const HandlerTable &current, EventTypeId type_id,
+                                std::shared_ptr<const HandlerListBase> list);
+
+        RML_EXPORT void enqueue_deferred(DeferredEvent &&deferred);
+
+        DeferredQueue &thread_queue();
+
+        std::mutex write_mutex;
+        std::atomic<std::shared_ptr<const HandlerTable> > handlers;
+        HandlerId next_handler_id{1};
+
+        // One queue per emitting thread, so producers never contend with each other. The thread holds its queue
+        // until it exits; the drain then removes it once it's empty.
+        std::mutex queues_mutex;
+        std::vector<std::shared_ptr<DeferredQueue> > deferred_queues;
+        std::atomic<std::size_t> pending_deferred{0};
+        std::atomic<std::size_t> dropped_deferred{0};
+        std::atomic_flag drain_flag;
+        std::uint32_t instance_id;
     };
 
     inline EventManager *g_event_manager{};
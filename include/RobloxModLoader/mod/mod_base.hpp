@@ -36,10 +36,14 @@ public:
 
 protected:
     template<typename T>
-    void register_event_handler(events::EventManager::EventHandler<T> handler) {
+    events::EventManager::HandlerId register_event_handler(
+        events::EventManager::EventHandler<T> handler,
+        const events::EventPriority priority = events::EventPriority::Normal,
+        const events::EventDelivery delivery = events::EventDelivery::Immediate) {
         if (event_manager) {
-            event_manager->registerHandler<T>(handler);
+            return event_manager->registerHandler<T>(std::move(handler), priority, delivery);
         }
+        return 0;
     }
 
 private:
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rml::util {
+    // Case-insensitive path glob compiled once into a small NFA and matched without backtracking, in
+    // O(path length * pattern states). Paths use '/' separators.
+    //   *       any run of characters within one segment
+    //   ?       one character other than '/'
+    //   [a-z]   character class, negated with [!...] or [^...]; never matches '/'
+    //   **/     zero or more whole directories
+    //   **      anything, including '/'
+    class GlobPattern final {
+    public:
+        static constexpr std::size_t MAX_STATES = 256;
+
+        [[nodiscard]] static std::expected<GlobPattern, std::string> compile(const std::string_view pattern) {
+            GlobPattern glob;
+            glob.m_pattern = pattern;
+
+            for (std::size_t i = 0; i < pattern.size(); ++i) {
+                switch (const auto c = pattern[i]) {
+                    case '*':
+                        if (i + 1 < pattern.size() && pattern[i + 1] == '*') {
+                            const auto run_start = i;
+                            while (i + 1 < pattern.size() && pattern[i + 1] == '*') {
+                                ++i;
+                            }
+
+                            // Only a whole "**" segment spans directories; "***" or "a**" is a plain globstar
+                            const bool whole_segment = i - run_start == 1
+                                                       && (run_start == 0 || pattern[run_start - 1] == '/');
+                            if (whole_segment && i + 1 < pattern.size() && pattern[i + 1] == '/') {
+                                ++i;
+                                glob.m_states.push_back(State{.kind = Kind::DirEntry});
+                                glob.m_states.push_back(State{.kind = Kind::DirLoop});
+                            } else {
+                                glob.m_states.push_back(State{.kind = Kind::Globstar});
+                            }
+                        } else {
+                            glob.m_states.push_back(State{.kind = Kind::Star});
+                        }
+                        break;
+
+                    case '?':
+                        glob.m_states.push_back(State{.kind = Kind::Any});
+                        break;
+
+                    case '[': {
+                        auto end = i + 1;
+                        if (end < pattern.size() && (pattern[end] == '!' || pattern[end] == '^')) {
+                            ++end;
+                        }
+                        if (end < pattern.size() && pattern[end] == ']') {
+                            ++end; // A leading ']' is a literal member
+                        }
+                        while (end < pattern.size() && pattern[end] != ']') {
+                            ++end;
+                        }
+                        if (end >= pattern.size()) {
+                            return std::unexpected(std::format("Unterminated character class in '{}'", pattern));
+                        }
+
+                        glob.m_states.push_back(State{
+                            .kind = Kind::Class,
+                            .class_index = static_cast<std::uint16_t>(glob.m_classes.size())
+                        });
+                        glob.m_classes.push_back(parse_class(pattern.substr(i + 1, end - i - 1)));
+                        i = end;
+                        break;
+                    }
+
+                    default:
+                        glob.m_states.push_back(State{.kind = Kind::Literal, .literal = to_lower(c)});
+                        break;
+                }
+
+                if (glob.m_states.size() >= MAX_STATES) {
+                    return std::unexpected(std::format("Pattern '{}' is too long", pattern));
+                }
+            }
+
+            return glob;
+        }
+
+        [[nodiscard]] bool matches(const std::string_view path) const noexcept {
+            StateSet current{};
+            current.set(0);
+            close(current);
+
+            for (const auto raw: path) {
+                const auto c = to_lower(raw);
+                StateSet next{};
+
+                for (std::size_t i = 0; i < m_states.size(); ++i) {
+                    if (current.test(i)) {
+                        step(i, c, next);
+                    }
+                }
+
+                if (next.none()) {
+                    return false;
+                }
+
+                close(next);
+                current = next;
+            }
+
+            return current.test(m_states.size());
+        }
+
+        [[nodiscard]] const std::string &pattern() const noexcept {
+            return m_pattern;
+        }
+
+    private:
+        enum class Kind : std::uint8_t {
+            Literal,
+            Any,
+            Class,
+            Star,
+            Globstar,
+            DirEntry, // First character of a "**/" directory
+            DirLoop // Rest of a "**/" directory, leaves on '/'
+        };
+
+        struct State {
+            Kind kind{Kind::Literal};
+            char literal{0};
+            std::uint16_t class_index{0};
+        };
+
+        using StateSet = std::bitset<MAX_STATES + 1>; // +1 for the accepting state
+        using CharClass = std::bitset<256>;
+
+        [[nodiscard]] static constexpr char to_lower(const char c) noexcept {
+            return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        [[nodiscard]] static CharClass parse_class(std::string_view body) {
+            CharClass members;
+
+            bool negated = false;
+            if (!body.empty() && (body.front() == '!' || body.front() == '^')) {
+                negated = true;
+                body.remove_prefix(1);
+            }
+
+            for (std::size_t i = 0; i < body.size(); ++i) {
+                auto first = static_cast<unsigned char>(to_lower(body[i]));
+                auto last = first;
+
+                if (i + 2 < body.size() && body[i + 1] == '-') {
+                    last = static_cast<unsigned char>(to_lower(body[i + 2]));
+                    i += 2;
+                }
+
+                for (auto member = static_cast<unsigned>(first); member <= last; ++member) {
+                    members.set(member);
+                }
+            }
+
+            if (negated) {
+                members.flip();
+            }
+            members.reset('/');
+            return members;
+        }
+
+        // Epsilon transitions only go forward, so one ascending pass reaches the closure.
+        void close(StateSet &states) const noexcept {
+            for (std::size_t i = 0; i < m_states.size(); ++i) {
+                if (!states.test(i)) {
+                    continue;
+                }
+
+                switch (m_states[i].kind) {
+                    case Kind::Star:
+                    case Kind::Globstar:
+                        states.set(i + 1);
+                        break;
+                    case Kind::DirEntry:
+                        states.set(i + 2); // Zero directories
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void step(const std::size_t index, const char c, StateSet &next) const noexcept {
+            const auto &state = m_states[index];
+
+            switch (state.kind) {
+                case Kind::Literal:
+                    if (c == state.literal) {
+                        next.set(index + 1);
+                    }
+                    break;
+                case Kind::Any:
+                    if (c != '/') {
+                        next.set(index + 1);
+                    }
+                    break;
+                case Kind::Class:
+                    if (m_classes[state.class_index].test(static_cast<unsigned char>(c))) {
+                        next.set(index + 1);
+                    }
+                    break;
+                case Kind::Star:
+                    if (c != '/') {
+                        next.set(index);
+                    }
+                    break;
+                case Kind::Globstar:
+                    next.set(index);
+                    break;
+                case Kind::DirEntry:
+                    if (c != '/') {
+                        next.set(index + 1);
+                    }
+                    break;
+                case Kind::DirLoop:
+                    next.set(index); // '/' may also start a deeper directory
+                    if (c == '/') {
+                        next.set(index + 1);
+                    }
+                    break;
+            }
+        }
+
+        std::string m_pattern;
+        std::vector<State> m_states;
+        std::vector<CharClass> m_classes;
+    };
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace rml::util {
+    // Log-linear histogram (HdrHistogram style): each power of two is split into SUB_BUCKETS linear steps, so
+    // a recorded value is off by at most 1/SUB_BUCKETS of itself. Recording is a relaxed fetch_add into the
+    // calling thread's shard; readers merge the shards. Threads get shards round-robin in the order they first
+    // record, so the first SHARD_COUNT writers each have one to themselves and later ones share.
+    class LogLinearHistogram final {
+    public:
+        static constexpr std::size_t SUB_BUCKET_BITS = 3;
+        static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SUB_BUCKET_BITS;
+        static constexpr std::size_t MAX_EXPONENT = 40; // Values at or above 2^40 land in the last bucket
+        static constexpr std::size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+        static constexpr std::size_t SHARD_COUNT = 4;
+
+        struct Summary {
+            std::uint64_t count{0};
+            std::uint64_t p50{0};
+            std::uint64_t p95{0};
+            std::uint64_t p99{0};
+            std::uint64_t max{0};
+        };
+
+        LogLinearHistogram() = default;
+
+        LogLinearHistogram(const LogLinearHistogram &) = delete;
+
+        LogLinearHistogram &operator=(const LogLinearHistogram &) = delete;
+
+        void record(const std::uint64_t value) noexcept {
+            auto &shard = m_shards[shard_index()];
+
+            shard.buckets[bucket_for(value)].fetch_add(1, std::memory_order_relaxed);
+
+            auto current = shard.max.load(std::memory_order_relaxed);
+            while (value > current && !shard.max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        [[nodiscard]] Summary summarize() const noexcept {
+            std::array<std::uint64_t, BUCKET_COUNT> counts{};
+            Summary summary;
+
+            for (const auto &shard: m_shards) {
+                for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                    const auto count = shard.buckets[i].load(std::memory_order_relaxed);
+                    counts[i] += count;
+                    summary.count += count;
+                }
+                summary.max = std::max(summary.max, shard.max.load(std::memory_order_relaxed));
+            }
+
+            if (summary.count == 0) {
+                return summary;
+            }
+
+            const auto rank_for = [&summary](const double quantile) {
+                return std::max<std::uint64_t>(
+                    1, static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(summary.count))));
+            };
+
+            const std::array<std::uint64_t, 3> ranks{rank_for(0.50), rank_for(0.95), rank_for(0.99)};
+            std::array<std::uint64_t, 3> values{};
+            std::size_t next = 0;
+            std::uint64_t seen = 0;
+
+            for (std::size_t i = 0; i < BUCKET_COUNT && next < ranks.size(); ++i) {
+                seen += counts[i];
+                while (next < ranks.size() && seen >= ranks[next]) {
+                    // Report the highest value the bucket can hold, but never above what was actually seen
+                    values[next++] = std::min(bucket_upper_bound(i), summary.max);
+                }
+            }
+
+            summary.p50 = values[0];
+            summary.p95 = values[1];
+            summary.p99 = values[2];
+            return summary;
+        }
+
+        [[nodiscard]] static constexpr std::size_t bucket_for(const std::uint64_t value) noexcept {
+            if (value < SUB_BUCKETS) {
+                return static_cast<std::size_t>(value);
+            }
+
+            const auto exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+            if (exponent >= MAX_EXPONENT) {
+                return BUCKET_COUNT - 1;
+            }
+
+            const auto shift = exponent - SUB_BUCKET_BITS;
+            const auto sub_bucket = static_cast<std::size_t>(value >> shift) & (SUB_BUCKETS - 1);
+            return (shift + 1) * SUB_BUCKETS + sub_bucket;
+        }
+
+        [[nodiscard]] static constexpr std::uint64_t bucket_upper_bound(const std::size_t index) noexcept {
+            if (index < SUB_BUCKETS) {
+                return index;
+            }
+
+            const auto shift = index / SUB_BUCKETS - 1;
+            const auto lower = static_cast<std::uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+            return lower + (std::uint64_t{1} << shift) - 1;
+        }
+
+    private:
+        struct alignas(64) Shard {
+            std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+            std::atomic<std::uint64_t> max{0};
+        };
+
+        [[nodiscard]] static std::size_t shard_index() noexcept {
+            thread_local const std::size_t index = s_next_shard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+            return index;
+        }
+
+        static inline std::atomic<std::size_t> s_next_shard{0}; // Shared by all histograms
+
+        std::array<Shard, SHARD_COUNT> m_shards{};
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace rml::util {
+    // Bounded multi-producer / single-consumer ring buffer (Vyukov style). Producers claim a slot with a
+    // single CAS on the enqueue position; the consumer never contends with producers on a shared counter.
+    // Capacity is rounded up to a power of two and fixed after construction.
+    template<typename T>
+    class MpscRingBuffer final {
+        struct Cell {
+            std::atomic<std::size_t> sequence{0};
+            std::optional<T> value;
+        };
+
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    public:
+        explicit MpscRingBuffer(const std::size_t capacity = 1024) {
+            reset(capacity);
+        }
+
+        MpscRingBuffer(const MpscRingBuffer &) = delete;
+
+        MpscRingBuffer &operator=(const MpscRingBuffer &) = delete;
+
+        MpscRingBuffer(MpscRingBuffer &&) = delete;
+
+        MpscRingBuffer &operator=(MpscRingBuffer &&) = delete;
+
+        // Not thread-safe; only valid while no producer or consumer is active.
+        void reset(const std::size_t capacity) {
+            const auto rounded = std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity);
+
+            m_cells = std::make_unique<Cell[]>(rounded);
+            m_mask = rounded - 1;
+
+            for (std::size_t i = 0; i < rounded; ++i) {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            m_enqueue_pos.store(0, std::memory_order_relaxed);
+            m_dequeue_pos.store(0, std::memory_order_relaxed);
+        }
+
+        // Moves from value only on success.
+        [[nodiscard]] bool try_push(T &&value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            Cell *cell;
+            auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+
+                const auto sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false; // Full
+                } else {
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value.emplace(std::move(value));
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Single consumer only.
+        [[nodiscard]] std::optional<T> try_pop() noexcept(std::is_nothrow_move_constructible_v<T>) {
+            const auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            auto &cell = m_cells[pos & m_mask];
+
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1) < 0) {
+                return std::nullopt; // Empty, or the producer that claimed this slot hasn't published yet
+            }
+
+            std::optional<T> result{std::move(cell.value)};
+            cell.value.reset();
+
+            cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+            m_dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+            return result;
+        }
+
+        [[nodiscard]] std::size_t size_approx() const noexcept {
+            const auto dequeue = m_dequeue_pos.load(std::memory_order_relaxed);
+            const auto enqueue = m_enqueue_pos.load(std::memory_order_relaxed);
+            return enqueue > dequeue ? enqueue - dequeue : 0;
+        }
+
+        [[nodiscard]] bool empty_approx() const noexcept {
+            return size_approx() == 0;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept {
+            return m_mask + 1;
+        }
+
+    private:
+        std::unique_ptr<Cell[]> m_cells;
+        std::size_t m_mask{0};
+
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueue_pos{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeue_pos{0};
+    };
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace rml::util {
+    // Lazily started coroutine producing one T. Nothing runs until the task is awaited (or handed to spawn /
+    // to_future); completion resumes the awaiting coroutine on whichever thread finished the task.
+    template<typename T>
+    class [[nodiscard]] Task final {
+    public:
+        struct promise_type {
+            std::optional<T> value;
+            std::exception_ptr exception;
+            std::coroutine_handle<> continuation;
+
+            Task get_return_object() noexcept {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            auto final_suspend() const noexcept {
+                // Hands control straight to the awaiting coroutine instead of resuming it on top of this frame
+                struct FinalAwaiter {
+                    bool await_ready() const noexcept {
+                        return false;
+                    }
+
+                    std::coroutine_handle<> await_suspend(
+                        const std::coroutine_handle<promise_type> handle) const noexcept {
+                        if (const auto continuation = handle.promise().continuation) {
+                            return continuation;
+                        }
+                        return std::noop_coroutine();
+                    }
+
+                    void await_resume() const noexcept {
+                    }
+                };
+
+                return FinalAwaiter{};
+            }
+
+            template<typename U = T>
+                requires std::is_convertible_v<U &&, T>
+            void return_value(U &&result) noexcept(std::is_nothrow_constructible_v<T, U &&>) {
+                value.emplace(std::forward<U>(result));
+            }
+
+            void unhandled_exception() noexcept {
+                exception = std::current_exception();
+            }
+        };
+
+        Task(Task &&other) noexcept : m_handle(std::exchange(other.m_handle, {})) {
+        }
+
+        Task &operator=(Task &&other) noexcept {
+            if (this != &other) {
+                destroy();
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+
+        Task &operator=(const Task &) = delete;
+
+        ~Task() noexcept {
+            destroy();
+        }
+
+        [[nodiscard]] bool is_ready() const noexcept {
+            return !m_handle || m_handle.done();
+        }
+
+        bool await_ready() const noexcept {
+            return is_ready();
+        }
+
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+            m_handle.promise().continuation = awaiting;
+            return m_handle;
+        }
+
+        T await_resume() {
+            auto &promise = m_handle.promise();
+            if (promise.exception) {
+                std::rethrow_exception(promise.exception);
+            }
+            return std::move(*promise.value);
+        }
+
+    private:
+        explicit Task(const std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {
+        }
+
+        void destroy() noexcept {
+            if (m_handle) {
+                m_handle.destroy();
+                m_handle = {};
+            }
+        }
+
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    namespace detail {
+        // Coroutine that starts immediately and frees itself when it finishes
+        struct DetachedTask {
+            struct promise_type {
+                DetachedTask get_return_object() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept {
+                    return {};
+                }
+
+                void return_void() const noexcept {
+                }
+
+                // Detached bodies catch what the task throws and their callbacks are noexcept, so nothing can
+                // end up here without a bug; don't let it vanish silently
+                void unhandled_exception() const noexcept {
+                    std::terminate();
+                }
+            };
+        };
+
+        template<typename T, typename F, typename E>
+        DetachedTask run_detached(Task<T> task, F on_complete, E on_error) {
+            std::optional<T> result;
+            std::exception_ptr error;
+
+            try {
+                result.emplace(co_await std::move(task));
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            if (error) {
+                on_error(error);
+            } else {
+                on_complete(std::move(*result));
+            }
+        }
+
+        template<typename T>
+        DetachedTask fulfil(Task<T> task, std::promise<T> promise) {
+            try {
+                promise.set_value(co_await std::move(task));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    // Starts task and calls on_complete with its result where it finishes, or on_error with what it threw.
+    // Neither callback may throw.
+    template<typename T, typename F, typename E>
+        requires std::invocable<F &, T> && std::invocable<E &, std::exception_ptr>
+    void spawn(Task<T> task, F on_complete, E on_error) {
+        detail::run_detached(std::move(task), std::move(on_complete), std::move(on_error));
+    }
+
+    // Message of the exception in error, for reporting
+    [[nodiscard]] inline std::string describe_exception(const std::exception_ptr &error) noexcept {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception &e) {
+            return e.what();
+        } catch (...) {
+            return "Unknown exception";
+        }
+    }
+
+    // Adapter for callers that want to block on the result
+    template<typename T>
+    [[nodiscard]] std::future<T> to_future(Task<T> task) {
+        std::promise<T> promise;
+        auto future = promise.get_future();
+        detail::fulfil(std::move(task), std::move(promise));
+        return future;
+    }
+
+    template<typename T>
+    [[nodiscard]] Task<T> make_ready_task(T value) {
+        co_return std::move(value);
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace rml::util {
+    // Fixed-size pool of worker threads fed from one FIFO queue. Destruction finishes queued work, then joins.
+    class ThreadPool final {
+    public:
+        explicit ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency()) {
+            thread_count = thread_count == 0 ? 1 : thread_count;
+            m_workers.reserve(thread_count);
+
+            for (std::size_t i = 0; i < thread_count; ++i) {
+                m_workers.emplace_back([this](const std::stop_token &stop_token) { worker_loop(stop_token); });
+            }
+        }
+
+        ~ThreadPool() noexcept {
+            for (auto &worker: m_workers) {
+                worker.request_stop();
+            }
+            m_condition.notify_all();
+            m_workers.clear();
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ThreadPool(ThreadPool &&) = delete;
+
+        ThreadPool &operator=(ThreadPool &&) = delete;
+
+        template<typename F>
+        [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<F> > > submit(F &&task) {
+            using Result = std::invoke_result_t<std::decay_t<F> >;
+
+            std::packaged_task<Result()> packaged(std::forward<F>(task));
+            auto future = packaged.get_future();
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_tasks.emplace_back(std::move(packaged));
+            }
+            m_condition.notify_one();
+
+            return future;
+        }
+
+        // Runs fn on every element in parallel and waits for all of them; rethrows the first failure. Elements
+        // are passed by reference, so the range must own them (no generating views). Must not be called from a
+        // pool thread.
+        template<std::ranges::forward_range R, typename F>
+        void for_each(R &&range, F &&fn) {
+            std::vector<std::future<void> > pending;
+            if constexpr (std::ranges::sized_range<R>) {
+                pending.reserve(std::ranges::size(range));
+            }
+
+            for (auto &&item: range) {
+                pending.push_back(submit([&fn, &item] { fn(item); }));
+            }
+
+            std::exception_ptr failure;
+            for (auto &future: pending) {
+                try {
+                    future.get();
+                } catch (...) {
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return m_workers.size();
+        }
+
+    private:
+        void worker_loop(const std::stop_token &stop_token) {
+            for (;;) {
+                std::move_only_function<void()> task;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_condition.wait(lock, stop_token, [this] { return !m_tasks.empty(); });
+
+                    if (m_tasks.empty()) {
+                        return; // Stop requested and nothing left to run
+                    }
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_condition;
+        std::deque<std::move_only_function<void()> > m_tasks;
+        std::vector<std::jthread> m_workers;
+    };
+}
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+#include <luau/Compiler.h>
+
+#include "RobloxModLoader/luau/mod_package_format.hpp"
+
+namespace fs = std::filesystem;
+namespace format = rml::luau::package_format;
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+
+struct Options {
+    fs::path mod_directory;
+    fs::path output_file;
+    bool compress = true;
+    bool bytecode = true;
+    int optimization_level = 1;
+    int debug_level = 2; // Matches MOD_COMPILE_OPTIONS, which the loader compiles scripts and modules with
+};
+
+struct PendingEntry {
+    string path;
+    format::EntryKind kind;
+    string data;
+};
+
+bool is_script(const fs::path &relative_path) {
+    const auto extension = relative_path.extension().string();
+    const auto first = relative_path.begin() != relative_path.end() ? relative_path.begin()->string() : string();
+    return first == "scripts" && (extension == ".lua" || extension == ".luau");
+}
+
+bool read_file(const fs::path &path, string &data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    data.assign(std::istreambuf_iterator(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+std::vector<PendingEntry> collect_entries(const Options &options) {
+    std::vector<PendingEntry> entries;
+
+    Luau::CompileOptions compile_options;
+    compile_options.optimizationLevel = options.optimization_level;
+    compile_options.debugLevel = options.debug_level;
+
+    for (auto it = fs::recursive_directory_iterator(options.mod_directory); it != fs::recursive_directory_iterator();
+         ++it) {
+        const auto relative_path = it->path().lexically_relative(options.mod_directory);
+
+        // Skip dot files and directories such as .rml_cache and .git
+        if (relative_path.filename().string().starts_with('.')) {
+            if (it->is_directory()) {
+                it.disable_recursion_pending();
+            }
+            continue;
+        }
+
+        if (!it->is_regular_file()) {
+            continue;
+        }
+
+        PendingEntry entry{.path = relative_path.generic_string(), .kind = format::EntryKind::File};
+        if (entry.path.size() > UINT16_MAX) {
+            throw std::runtime_error(std::format("Path too long: {}", entry.path));
+        }
+
+        if (!read_file(it->path(), entry.data)) {
+            throw std::runtime_error(std::format("Failed to read {}", it->path().string()));
+        }
+
+        if (format::compare_paths(entry.path, format::MANIFEST_PATH) == 0) {
+            entry.kind = format::EntryKind::Manifest;
+        } else if (options.bytecode && is_script(relative_path)) {
+            auto bytecode = Luau::compile(entry.data, compile_options);
+            if (!bytecode.empty() && bytecode.front() != 0) {
+                entries.push_back(PendingEntry{
+                    .path = entry.path, .kind = format::EntryKind::Bytecode, .data = std::move(bytecode)
+                });
+            } else {
+                // Still packed as source; the loader reports the error with the rest of the mod's scripts
+                cerr << std::format("warning: {} does not compile: {}", entry.path,
+                                    bytecode.empty() ? string() : bytecode.substr(1)) << endl;
+            }
+        }
+
+        entries.push_back(std::move(entry));
+    }
+
+    std::ranges::sort(entries, [](const PendingEntry &lhs, const PendingEntry &rhs) {
+        if (lhs.kind != rhs.kind) {
+            return lhs.kind < rhs.kind;
+        }
+        return format::compare_paths(lhs.path, rhs.path) < 0;
+    });
+
+    // Paths that only differ in case would be ambiguous on lookup
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i - 1].kind == entries[i].kind &&
+            format::compare_paths(entries[i - 1].path, entries[i].path) == 0) {
+            throw std::runtime_error(std::format("Paths differ only in case: {} and {}", entries[i - 1].path,
+                                                 entries[i].path));
+        }
+    }
+
+    return entries;
+}
+
+void write_package(const Options &options, const std::vector<PendingEntry> &entries) {
+    std::ofstream out(options.output_file, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(std::format("Failed to create {}", options.output_file.string()));
+    }
+
+    format::Header header;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<format::Entry> index;
+    index.reserve(entries.size());
+    string strings;
+    uint64_t offset = sizeof(header);
+    size_t original_bytes = 0;
+
+    for (const auto &pending: entries) {
+        if (pending.data.size() > UINT32_MAX) {
+            throw std::runtime_error(std::format("{} is too large", pending.path));
+        }
+
+        format::Entry entry;
+        entry.kind = pending.kind;
+        if (pending.kind == format::EntryKind::Bytecode) {
+            entry.optimization_level = static_cast<uint8_t>(options.optimization_level);
+            entry.debug_level = static_cast<uint8_t>(options.debug_level);
+            entry.bytecode_version = static_cast<uint8_t>(pending.data.front());
+        }
+        entry.size = static_cast<uint32_t>(pending.data.size());
+        entry.crc32 = static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0),
+                                                  reinterpret_cast<const Bytef *>(pending.data.data()),
+                                                  static_cast<uInt>(pending.data.size())));
+        entry.path_offset = static_cast<uint32_t>(strings.size());
+        entry.path_size = static_cast<uint16_t>(pending.path.size());
+        strings += pending.path;
+
+        // Keep zlib output only when it actually saves space; the manifest is always stored raw
+        string stored = pending.data;
+        if (options.compress && pending.kind != format::EntryKind::Manifest && !pending.data.empty()) {
+            string compressed(compressBound(static_cast<uLong>(pending.data.size())), '\0');
+            auto compressed_size = static_cast<uLongf>(compressed.size());
+
+            if (compress2(reinterpret_cast<Bytef *>(compressed.data()), &compressed_size,
+                          reinterpret_cast<const Bytef *>(pending.data.data()),
+                          static_cast<uLong>(pending.data.size()), Z_BEST_COMPRESSION) == Z_OK &&
+                compressed_size < pending.data.size()) {
+                compressed.resize(compressed_size);
+                stored = std::move(compressed);
+                entry.compression = format::Compression::Zlib;
+            }
+        }
+
+        entry.data_offset = offset;
+        entry.stored_size = static_cast<uint32_t>(stored.size());
+        out.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+        offset += stored.size();
+        original_bytes += pending.data.size();
+
+        index.push_back(entry);
+    }
+
+    header.strings_offset = offset;
+    header.strings_size = strings.size();
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+    offset += strings.size();
+
+    // The loader reads the index in place, so it has to be aligned for Entry
+    const auto padding = (alignof(format::Entry) - offset % alignof(format::Entry)) % alignof(format::Entry);
+    out.write("\0\0\0\0\0\0\0\0", static_cast<std::streamsize>(padding));
+    offset += padding;
+
+    header.index_offset = offset;
+    out.write(reinterpret_cast<const char *>(index.data()),
+              static_cast<std::streamsize>(index.size() * sizeof(format::Entry)));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (!out) {
+        throw std::runtime_error(std::format("Failed to write {}", options.output_file.string()));
+    }
+
+    cout << std::format("Packed {} entries ({} bytes) into {} ({} bytes)", entries.size(), original_bytes,
+                        options.output_file.string(), offset + index.size() * sizeof(format::Entry)) << endl;
+}
+
+void print_usage() {
+    cerr << "Usage: rmlpkg.exe <mod_directory> [output.rmlpkg] [options]" << endl;
+    cerr << "  mod_directory: Mod folder containing mod.toml" << endl;
+    cerr << "  output.rmlpkg: Defaults to <mod_directory>.rmlpkg" << endl;
+    cerr << "  --store: Don't compress entries" << endl;
+    cerr << "  --no-bytecode: Don't include precompiled bytecode" << endl;
+    cerr << "  -O<n>, -g<n>: Luau optimization and debug level of the bytecode (default -O1 -g2)" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    std::vector<string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const string argument = argv[i];
+
+        if (argument == "--store") {
+            options.compress = false;
+        } else if (argument == "--no-bytecode") {
+            options.bytecode = false;
+        } else if (argument.size() == 3 && argument.starts_with("-O") && argument[2] >= '0' && argument[2] <= '2') {
+            options.optimization_level = argument[2] - '0';
+        } else if (argument.size() == 3 && argument.starts_with("-g") && argument[2] >= '0' && argument[2] <= '2') {
+            options.debug_level = argument[2] - '0';
+        } else if (argument.starts_with("-")) {
+            cerr << "Unknown option: " << argument << endl;
+            print_usage();
+            return -1;
+        } else {
+            positional.push_back(argument);
+        }
+    }
+
+    if (positional.empty() || positional.size() > 2) {
+        print_usage();
+        return -1;
+    }
+
+    options.mod_directory = fs::path(positional[0]).lexically_normal();
+    if (!options.mod_directory.has_filename()) {
+        options.mod_directory = options.mod_directory.parent_path();
+    }
+
+    options.output_file = positional.size() > 1
+                              ? fs::path(positional[1])
+                              : fs::path(options.mod_directory) += format::EXTENSION;
+
+    if (!fs::is_directory(options.mod_directory)) {
+        cerr << "Mod directory doesn't exist: " << options.mod_directory << endl;
+        return -1;
+    }
+
+    if (!fs::exists(options.mod_directory / format::MANIFEST_PATH)) {
+        cerr << "No mod.toml found in: " << options.mod_directory << endl;
+        return -1;
+    }
+
+    try {
+        write_package(options, collect_entries(options));
+    } catch (const std::exception &e) {
+        cerr << e.what() << endl;
+        return -1;
+    }
+
+    return 0;
+}
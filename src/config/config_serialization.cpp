@@ -95,6 +95,10 @@ namespace rml::config::serialization {
         table.insert_or_assign("enable_profiling", performance.enable_profiling);
         table.insert_or_assign("thread_pool_size", static_cast<std::int64_t>(performance.thread_pool_size));
         table.insert_or_assign("hook_timeout_ms", performance.hook_timeout.count());
+        table.insert_or_assign("enable_bytecode_cache", performance.enable_bytecode_cache);
+        table.insert_or_assign("bytecode_cache_size", static_cast<std::int64_t>(performance.bytecode_cache_size));
+        table.insert_or_assign("enable_disk_bytecode_cache", performance.enable_disk_bytecode_cache);
+        table.insert_or_assign("max_idle_lua_threads", static_cast<std::int64_t>(performance.max_idle_lua_threads));
 
         return table;
     }
@@ -119,6 +123,27 @@ namespace rml::config::serialization {
                 }
             }
 
+            if (const auto cache_node = table["enable_bytecode_cache"]) {
+                performance.enable_bytecode_cache = cache_node.value_or(performance.enable_bytecode_cache);
+            }
+
+            if (const auto cache_size_node = table["bytecode_cache_size"]) {
+                if (const auto size = cache_size_node.value<std::int64_t>()) {
+                    performance.bytecode_cache_size = static_cast<std::size_t>(*size);
+                }
+            }
+
+            if (const auto disk_cache_node = table["enable_disk_bytecode_cache"]) {
+                performance.enable_disk_bytecode_cache = disk_cache_node.value_or(
+                    performance.enable_disk_bytecode_cache);
+            }
+
+            if (const auto idle_threads_node = table["max_idle_lua_threads"]) {
+                if (const auto count = idle_threads_node.value<std::int64_t>(); count && *count >= 0) {
+                    performance.max_idle_lua_threads = static_cast<std::size_t>(*count);
+                }
+            }
+
             return performance;
         } catch (const std::exception &e) {
             std::cerr << "Failed to parse performance configuration: " << e.what() << std::endl;
@@ -213,6 +238,14 @@ namespace rml::config::serialization {
             runtime_table.insert_or_assign("dependencies_path", mod_config.runtime.dependencies_path->string());
         }
 
+        if (!mod_config.runtime.dependencies.empty()) {
+            toml::array dependencies_array;
+            for (const auto &dependency: mod_config.runtime.dependencies) {
+                dependencies_array.push_back(dependency);
+            }
+            runtime_table.insert_or_assign("dependencies", std::move(dependencies_array));
+        }
+
         table.insert_or_assign("runtime", std::move(runtime_table));
 
         // Resources configuration
@@ -328,6 +361,16 @@ namespace rml::config::serialization {
                         mod_config.runtime.dependencies_path = std::filesystem::path(*deps_str);
                     }
                 }
+
+                if (const auto dependencies_node = runtime_table["dependencies"];
+                    dependencies_node && dependencies_node.is_array()) {
+                    const auto &dependencies_array = *dependencies_node.as_array();
+                    for (const auto &item: dependencies_array) {
+                        if (const auto dependency = item.value<std::string>()) {
+                            mod_config.runtime.dependencies.push_back(*dependency);
+                        }
+                    }
+                }
             }
 
             // Resources configuration
@@ -479,6 +522,10 @@ namespace rml::config::serialization {
             result.is_valid = false;
         }
 
+        if (config.performance.enable_bytecode_cache && config.performance.bytecode_cache_size == 0) {
+            result.warnings.push_back("Bytecode cache size is 0, compiled scripts will not be kept in memory");
+        }
+
         // Validate security configuration
         if (config.security.max_memory_per_mod == 0) {
             result.warnings.push_back("Max memory per mod is set to 0, no memory limits will be enforced");
@@ -500,6 +547,16 @@ namespace rml::config::serialization {
             result.warnings.push_back("Mod version is empty");
         }
 
+        // Validate dependencies
+        for (const auto &dependency: config.runtime.dependencies) {
+            if (dependency.empty()) {
+                result.warnings.push_back("Empty mod dependency name is ignored");
+            } else if (dependency == config.name) {
+                result.errors.push_back(std::format("Mod '{}' cannot depend on itself", config.name));
+                result.is_valid = false;
+            }
+        }
+
         // Validate resources
         if (config.resources.max_memory_usage && *config.resources.max_memory_usage == 0) {
             result.warnings.push_back("Max memory usage is set to 0");
@@ -4,9 +4,7 @@
 uint64_t *hooks::on_authentication(uint64_t *_this, uint64_t doc_panel_provider, uint64_t q_image_provider) {
     if (events::g_event_manager) {
         events::AuthenticationEvent event(_this, doc_panel_provider, q_image_provider);
-        events::g_event_manager->emit(event);
-
-        if (event.cancelled) {
+        if (!events::g_event_manager->emit(event)) {
             return nullptr;
         }
     }
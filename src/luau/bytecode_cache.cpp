@@ -0,0 +1,269 @@
+#include "RobloxModLoader/luau/bytecode_cache.hpp"
+
+#include <bit>
+#include <cstring>
+
+#include <luau/Bytecode.h>
+
+namespace rml::luau {
+    namespace {
+        constexpr std::uint32_t DISK_MAGIC = 0x424C4D52; // "RMLB"
+        constexpr std::uint32_t DISK_FORMAT_VERSION = 2;
+        constexpr std::uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+        constexpr std::uint64_t SOURCE_SEED = 0x5F3759DF1B873593ull;
+        constexpr std::uint64_t CHECK_SEED = 0xC2B2AE3D27D4EB4Full;
+        constexpr std::uint64_t OPTIONS_SEED = 0x165667B19E3779F9ull;
+
+        struct DiskHeader {
+            std::uint32_t magic{DISK_MAGIC};
+            std::uint32_t version{DISK_FORMAT_VERSION};
+            std::uint32_t bytecode_version{LBC_VERSION_TARGET}; // Of the Luau that compiled it
+            BytecodeCache::Key key;
+        };
+
+        constexpr std::uint64_t mix(std::uint64_t value) noexcept {
+            value ^= value >> 33;
+            value *= 0xFF51AFD7ED558CCDull;
+            value ^= value >> 33;
+            value *= 0xC4CEB9FE1A85EC53ull;
+            value ^= value >> 33;
+            return value;
+        }
+
+        // Word-at-a-time multiply/rotate hash; not cryptographic, just fast and well distributed.
+        std::uint64_t hash_bytes(const std::string_view data, const std::uint64_t seed) noexcept {
+            auto hash = seed ^ (static_cast<std::uint64_t>(data.size()) * HASH_MULTIPLIER);
+
+            std::size_t offset = 0;
+            for (; offset + sizeof(std::uint64_t) <= data.size(); offset += sizeof(std::uint64_t)) {
+                std::uint64_t word;
+                std::memcpy(&word, data.data() + offset, sizeof(word));
+                hash = std::rotl(hash ^ (word * HASH_MULTIPLIER), 29) * HASH_MULTIPLIER;
+            }
+
+            if (offset < data.size()) {
+                std::uint64_t tail = 0;
+                std::memcpy(&tail, data.data() + offset, data.size() - offset);
+                hash = std::rotl(hash ^ (tail * HASH_MULTIPLIER), 29) * HASH_MULTIPLIER;
+            }
+
+            return mix(hash);
+        }
+
+        void hash_combine(std::uint64_t &hash, const std::uint64_t value) noexcept {
+            hash = mix(hash ^ (value + HASH_MULTIPLIER + (hash << 6) + (hash >> 2)));
+        }
+
+        void hash_combine(std::uint64_t &hash, const char *value) noexcept {
+            hash_combine(hash, value ? hash_bytes(value, OPTIONS_SEED) : 0);
+        }
+
+        void hash_combine(std::uint64_t &hash, const char *const *values) noexcept {
+            std::uint64_t count = 0;
+            for (auto it = values; it && *it; ++it, ++count) {
+                hash_combine(hash, *it);
+            }
+            hash_combine(hash, count);
+        }
+    }
+
+    std::string BytecodeCache::Key::to_string() const {
+        return std::format("{:016x}{:016x}{:016x}", source_hash, source_check, options_hash);
+    }
+
+    BytecodeCache::BytecodeCache(const std::size_t max_bytes, const bool enable_disk_cache)
+        : m_max_bytes(max_bytes)
+          , m_enable_disk_cache(enable_disk_cache) {
+        g_bytecode_cache = this;
+    }
+
+    BytecodeCache::~BytecodeCache() {
+        g_bytecode_cache = nullptr;
+    }
+
+    BytecodeCache::Key BytecodeCache::make_key(const std::string_view source,
+                                               const Luau::CompileOptions &options) noexcept {
+        // Only the options the loader sets by value take part; callback based options aren't hashable. The
+        // bytecode version does too, so a Luau update never reuses output of the old compiler.
+        std::uint64_t options_hash = OPTIONS_SEED;
+        hash_combine(options_hash, static_cast<std::uint64_t>(LBC_VERSION_TARGET));
+        hash_combine(options_hash, static_cast<std::uint64_t>(options.optimizationLevel));
+        hash_combine(options_hash, static_cast<std::uint64_t>(options.debugLevel));
+        hash_combine(options_hash, static_cast<std::uint64_t>(options.typeInfoLevel));
+        hash_combine(options_hash, static_cast<std::uint64_t>(options.coverageLevel));
+        hash_combine(options_hash, options.vectorLib);
+        hash_combine(options_hash, options.vectorCtor);
+        hash_combine(options_hash, options.vectorType);
+        hash_combine(options_hash, options.mutableGlobals);
+        hash_combine(options_hash, options.userdataTypes);
+
+        return Key{
+            .source_hash = hash_bytes(source, SOURCE_SEED),
+            .source_check = hash_bytes(source, CHECK_SEED),
+            .options_hash = options_hash,
+            .source_size = source.size()
+        };
+    }
+
+    BytecodeCache::Bytecode BytecodeCache::get_or_compile(const std::string_view source,
+                                                          const Luau::CompileOptions &options,
+                                                          const std::filesystem::path &mod_path) {
+        const auto key = make_key(source, options);
+
+        if (auto bytecode = find_in_memory(key)) {
+            m_memory_hits.fetch_add(1, std::memory_order_relaxed);
+            return bytecode;
+        }
+
+        // Packaged mods pass their .rmlpkg file, which has no directory to hold a disk tier
+        std::filesystem::path disk_file;
+        if (std::error_code ec; m_enable_disk_cache && !mod_path.empty() && std::filesystem::is_directory(mod_path, ec)) {
+            disk_file = mod_path / DISK_CACHE_DIRECTORY / (key.to_string() + ".luauc");
+
+            if (auto bytecode = read_from_disk(disk_file, key)) {
+                m_disk_hits.fetch_add(1, std::memory_order_relaxed);
+                insert_in_memory(key, bytecode);
+                return bytecode;
+            }
+        }
+
+        // Compiled outside the lock; two threads missing on the same source both compile, first insert wins
+        auto bytecode = std::make_shared<const std::string>(Luau::compile(std::string(source), options));
+        m_compilations.fetch_add(1, std::memory_order_relaxed);
+
+        if (is_compile_error(*bytecode)) {
+            return bytecode;
+        }
+
+        insert_in_memory(key, bytecode);
+
+        if (!disk_file.empty()) {
+            write_to_disk(disk_file, key, *bytecode);
+        }
+
+        return bytecode;
+    }
+
+    void BytecodeCache::clear() noexcept {
+        std::lock_guard lock(m_mutex);
+        m_index.clear();
+        m_lru.clear();
+        m_bytes = 0;
+    }
+
+    BytecodeCache::Statistics BytecodeCache::get_statistics() const noexcept {
+        Statistics stats{
+            .memory_hits = m_memory_hits.load(std::memory_order_relaxed),
+            .disk_hits = m_disk_hits.load(std::memory_order_relaxed),
+            .compilations = m_compilations.load(std::memory_order_relaxed),
+            .evictions = m_evictions.load(std::memory_order_relaxed)
+        };
+
+        std::lock_guard lock(m_mutex);
+        stats.entries = m_index.size();
+        stats.bytes = m_bytes;
+        return stats;
+    }
+
+    BytecodeCache::Bytecode BytecodeCache::find_in_memory(const Key &key) {
+        std::lock_guard lock(m_mutex);
+
+        const auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return nullptr;
+        }
+
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->bytecode;
+    }
+
+    void BytecodeCache::insert_in_memory(const Key &key, const Bytecode &bytecode) {
+        if (bytecode->size() > m_max_bytes) {
+            return;
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        if (const auto it = m_index.find(key); it != m_index.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return;
+        }
+
+        m_lru.push_front(Entry{.key = key, .bytecode = bytecode});
+        m_index.emplace(key, m_lru.begin());
+        m_bytes += bytecode->size();
+
+        while (m_bytes > m_max_bytes && !m_lru.empty()) {
+            const auto &victim = m_lru.back();
+            m_bytes -= victim.bytecode->size();
+            m_index.erase(victim.key);
+            m_lru.pop_back();
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    BytecodeCache::Bytecode BytecodeCache::read_from_disk(const std::filesystem::path &file,
+                                                          const Key &key) noexcept {
+        try {
+            std::ifstream stream(file, std::ios::binary);
+            if (!stream) {
+                return nullptr;
+            }
+
+            DiskHeader header;
+            if (!stream.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+                header.magic != DISK_MAGIC || header.version != DISK_FORMAT_VERSION ||
+                header.bytecode_version != LBC_VERSION_TARGET || !(header.key == key)) {
+                LOG_DEBUG("Ignoring stale bytecode cache file: {}", file.string());
+                return nullptr;
+            }
+
+            std::string bytecode{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+            if (is_compile_error(bytecode)) {
+                return nullptr;
+            }
+
+            return std::make_shared<const std::string>(std::move(bytecode));
+        } catch (const std::exception &e) {
+            LOG_WARN("Failed to read bytecode cache file '{}': {}", file.string(), e.what());
+            return nullptr;
+        }
+    }
+
+    void BytecodeCache::write_to_disk(const std::filesystem::path &file, const Key &key,
+                                      const std::string &bytecode) noexcept {
+        // Write beside the target and rename over it so concurrent readers never see a partial file
+        auto temp_file = file;
+        temp_file += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+        try {
+            std::filesystem::create_directories(file.parent_path());
+
+            {
+                std::ofstream stream(temp_file, std::ios::binary | std::ios::trunc);
+                const DiskHeader header{.key = key};
+                stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                stream.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+                if (!stream) {
+                    throw std::runtime_error("write failed");
+                }
+            }
+
+            std::filesystem::rename(temp_file, file);
+        } catch (const std::exception &e) {
+            LOG_WARN("Failed to write bytecode cache file '{}': {}", file.string(), e.what());
+
+            std::error_code ec;
+            std::filesystem::remove(temp_file, ec);
+        }
+    }
+
+    BytecodeCache::Bytecode compile_cached(const std::string_view source, const Luau::CompileOptions &options,
+                                           const std::filesystem::path &mod_path) {
+        if (g_bytecode_cache) {
+            return g_bytecode_cache->get_or_compile(source, options, mod_path);
+        }
+
+        return std::make_shared<const std::string>(Luau::compile(std::string(source), options));
+    }
+}
@@ -10,6 +10,102 @@
 #include <cstring>
 
 namespace rml::luau::environment {
+    namespace {
+        // Calls f with "mod.function", built on the stack when it fits
+        template<typename F>
+        decltype(auto) with_full_name(const std::string_view mod_name, const std::string_view function_name, F &&f) {
+            std::array<char, 128> buffer;
+            const auto size = static_cast<size_t>(
+                std::format_to_n(buffer.data(), buffer.size(), "{}.{}", mod_name, function_name).size);
+
+            if (size > buffer.size()) {
+                return f(std::string_view(std::format("{}.{}", mod_name, function_name)));
+            }
+            return f(std::string_view(buffer.data(), size));
+        }
+
+        // Name of the mod whose script is running on L; empty outside a mod environment
+        std::string running_mod_name(lua_State *L) {
+            std::string mod_name;
+            lua_getglobal(L, "_RML_MOD_CONTEXT");
+            if (lua_istable(L, -1)) {
+                lua_getfield(L, -1, "name");
+                if (lua_isstring(L, -1)) {
+                    mod_name = lua_tostring(L, -1);
+                }
+                lua_pop(L, 1);
+            }
+            lua_pop(L, 1);
+            return mod_name;
+        }
+
+        // Anchors the function at index, and a thread of its own to run it on, in L's registry. Script threads are
+        // recycled once they finish, so the callback can't run on the one that registered it.
+        std::shared_ptr<LuaCallbackRefs> anchor_callback(lua_State *L, const int index) {
+            const int callback_ref = lua_ref(L, index);
+
+            lua_State *callback_thread = lua_newthread(L);
+            const int thread_ref = lua_ref(L, -1);
+            lua_pop(L, 1);
+
+            return std::make_shared<LuaCallbackRefs>(lua_mainthread(L), callback_thread, callback_ref, thread_ref);
+        }
+    }
+
+    LuaCallbackRefs::LuaCallbackRefs(lua_State *owner, lua_State *thread, const int callback_ref,
+                                     const int thread_ref) noexcept
+        : owner(owner)
+          , thread(thread)
+          , callback_ref(callback_ref)
+          , thread_ref(thread_ref) {
+    }
+
+    LuaCallbackRefs::~LuaCallbackRefs() noexcept {
+        // The last holder is a listener snapshot or the registration, both let go of on the game thread. Never
+        // removed (or removed after its state went away) means there is nothing to release.
+        if (release_in) {
+            lua_unref(release_in, callback_ref);
+            lua_unref(release_in, thread_ref);
+        }
+    }
+
+    BridgeResult<BridgeValues> PreparedLuauCall::call(const BridgeValues parameters, BridgeArena &arena) const {
+        const auto bridge = BridgeProvider::instance();
+        if (!m_slot || !bridge) {
+            return std::unexpected("Prepared call is not valid");
+        }
+        return bridge->call_luau_slot(*m_slot, parameters, arena);
+    }
+
+    BridgeResult<LuaParameters> PreparedLuauCall::call(const LuaParameters &parameters) const {
+        const auto bridge = BridgeProvider::instance();
+        if (!m_slot || !bridge) {
+            return std::unexpected("Prepared call is not valid");
+        }
+
+        try {
+            BridgeArena arena;
+            const auto results = bridge->call_luau_slot(*m_slot, BridgeProvider::from_lua_parameters(parameters, arena),
+                                                        arena, false);
+            if (!results) {
+                return std::unexpected(results.error());
+            }
+
+            return BridgeProvider::to_lua_parameters(*results);
+        } catch (const std::exception &e) {
+            return std::unexpected(std::format("Exception calling Luau function: {}", e.what()));
+        }
+    }
+
+    BridgeResult<std::shared_ptr<BridgeCallToken> > PreparedLuauCall::call_async(
+        LuaParameters parameters, AsyncCallCallback on_complete) const {
+        const auto bridge = BridgeProvider::instance();
+        if (!m_slot || !bridge) {
+            return std::unexpected("Prepared call is not valid");
+        }
+        return bridge->enqueue_async_call(m_slot, std::move(parameters), std::move(on_complete));
+    }
+
     EventListenerHandle::EventListenerHandle(std::string event_name, const size_t listener_id)
         : event_name(std::move(event_name)), listener_id(listener_id), valid(true) {
     }
@@ -51,11 +147,19 @@ namespace rml::luau::environment {
         return valid;
     }
 
-    BridgeProvider::BridgeProvider() : lua_state(nullptr), next_listener_id(1) {
+    BridgeProvider::BridgeProvider()
+        : lua_state(nullptr)
+          , event_listeners(std::make_shared<const EventListenerMap>())
+          , next_listener_id(1) {
         g_bridge_provider = this;
     }
 
     BridgeProvider::~BridgeProvider() {
+        // Nobody would ever complete these otherwise
+        while (auto call = async_calls.try_pop()) {
+            call->token->complete(std::unexpected("Bridge provider was destroyed"));
+        }
+
         std::lock_guard lock(instance_mutex);
         lua_state = nullptr;
         g_bridge_provider = nullptr;
@@ -86,14 +190,30 @@ namespace rml::luau::environment {
         std::string_view mod_name,
         std::string_view function_name,
         NativeFunctionCallback callback) {
+        if (!callback) {
+            return std::unexpected("Callback cannot be empty");
+        }
+
+        return register_native_value_function(
+            mod_name, function_name,
+            [callback = std::move(callback)](const BridgeValues arguments, BridgeArena &arena) {
+                return from_lua_parameters(callback(to_lua_parameters(arguments)), arena);
+            });
+    }
+
+    BridgeResult<void> BridgeProvider::register_native_value_function(
+        std::string_view mod_name,
+        std::string_view function_name,
+        NativeValueCallback callback) {
         if (mod_name.empty() || function_name.empty()) {
             return std::unexpected("Mod name and function name cannot be empty");
         }
 
-        const std::string full_name = std::format("{}.{}", mod_name, function_name);
+        std::string full_name = std::format("{}.{}", mod_name, function_name);
+        auto shared_callback = std::make_shared<const NativeValueCallback>(std::move(callback));
 
         std::unique_lock lock(mutex);
-        native_functions[full_name] = std::move(callback);
+        native_functions.insert_or_assign(std::move(full_name), std::move(shared_callback));
 
         return {};
     }
@@ -102,48 +222,259 @@ namespace rml::luau::environment {
         std::string_view mod_name,
         std::string_view function_name,
         const LuaParameters &parameters) const {
+        if (mod_name.empty() || function_name.empty()) {
+            return std::unexpected("Mod name and function name cannot be empty");
+        }
+
+        try {
+            BridgeArena arena;
+            const auto results = call_luau_slot(*get_luau_function_slot(mod_name, function_name),
+                                                from_lua_parameters(parameters, arena), arena, false);
+            if (!results) {
+                return std::unexpected(results.error());
+            }
+
+            return to_lua_parameters(*results);
+        } catch (const std::exception &e) {
+            return std::unexpected(std::format("Exception calling Luau function: {}", e.what()));
+        }
+    }
+
+    BridgeResult<BridgeValues> BridgeProvider::call_luau_function_values(
+        std::string_view mod_name,
+        std::string_view function_name,
+        const BridgeValues parameters,
+        BridgeArena &arena) const {
+        if (mod_name.empty() || function_name.empty()) {
+            return std::unexpected("Mod name and function name cannot be empty");
+        }
+
+        return call_luau_slot(*get_luau_function_slot(mod_name, function_name), parameters, arena);
+    }
+
+    BridgeResult<PreparedLuauCall> BridgeProvider::prepare_luau_function(
+        const std::string_view mod_name,
+        const std::string_view function_name) {
+        if (mod_name.empty() || function_name.empty()) {
+            return std::unexpected("Mod name and function name cannot be empty");
+        }
+
+        return PreparedLuauCall(get_luau_function_slot(mod_name, function_name));
+    }
+
+    std::shared_ptr<LuauFunctionSlot> BridgeProvider::get_luau_function_slot(
+        const std::string_view mod_name,
+        const std::string_view function_name) const {
+        return with_full_name(mod_name, function_name, [&](const std::string_view full_name) {
+            std::lock_guard lock(luau_functions_mutex);
+            if (const auto it = luau_functions.find(full_name); it != luau_functions.end()) {
+                return it->second;
+            }
+
+            auto slot = std::make_shared<LuauFunctionSlot>();
+            slot->mod_name = mod_name;
+            slot->function_name = function_name;
+            luau_functions.emplace(std::string(full_name), slot);
+            return slot;
+        });
+    }
+
+    BridgeResult<BridgeValues> BridgeProvider::call_luau_slot(LuauFunctionSlot &slot,
+                                                              const BridgeValues parameters,
+                                                              BridgeArena &arena,
+                                                              const bool nested_results) const {
         std::lock_guard lock(instance_mutex);
         if (!lua_state) {
             return std::unexpected("Lua state not available");
         }
 
+        const auto main_thread = lua_mainthread(lua_state);
+        const int base = lua_gettop(lua_state);
+
         try {
-            std::string full_name = std::format("{}.{}", mod_name, function_name);
-            lua_getglobal(lua_state, mod_name.data());
-            if (!lua_istable(lua_state, -1)) {
-                lua_pop(lua_state, 1);
-                return std::unexpected(std::format("Mod '{}' not found", mod_name));
-            }
-            lua_getfield(lua_state, -1, function_name.data());
-            if (!lua_isfunction(lua_state, -1)) {
-                lua_pop(lua_state, 2);
-                return std::unexpected(std::format("Function '{}.{}' not found", mod_name, function_name));
-            }
-            push_lua_parameters(lua_state, parameters);
+            int ref = LUA_NOREF;
+            {
+                std::lock_guard slot_lock(luau_functions_mutex);
+                if (slot.owner == main_thread) {
+                    ref = slot.ref;
+                }
+            }
+
+            // Not cached (or cached for another state): fall back to a global mod table
+            if (ref == LUA_NOREF) {
+                lua_getglobal(lua_state, slot.mod_name.c_str());
+                if (!lua_istable(lua_state, -1)) {
+                    lua_settop(lua_state, base);
+                    return std::unexpected(std::format("Mod '{}' not found", slot.mod_name));
+                }
+                lua_getfield(lua_state, -1, slot.function_name.c_str());
+                if (!lua_isfunction(lua_state, -1)) {
+                    lua_settop(lua_state, base);
+                    return std::unexpected(std::format("Function '{}.{}' not found", slot.mod_name,
+                                                       slot.function_name));
+                }
+
+                ref = lua_ref(lua_state, -1);
+                lua_settop(lua_state, base);
+
+                std::lock_guard slot_lock(luau_functions_mutex);
+                if (slot.ref != LUA_NOREF && slot.owner == main_thread) {
+                    lua_unref(lua_state, slot.ref);
+                }
+                slot.owner = main_thread;
+                slot.ref = ref;
+            }
+
+            lua_rawgeti(lua_state, LUA_REGISTRYINDEX, ref);
+            push_bridge_values(lua_state, parameters);
             if (lua_pcall(lua_state, static_cast<int>(parameters.size()), LUA_MULTRET, 0) != LUA_OK) {
                 std::string error = lua_tostring(lua_state, -1);
-                lua_pop(lua_state, 2); // error + mod table
-                return std::unexpected(std::format("Error calling function '{}': {}", full_name, error));
+                lua_settop(lua_state, base);
+                return std::unexpected(std::format("Error calling function '{}.{}': {}", slot.mod_name,
+                                                   slot.function_name, error));
             }
 
-            const int num_results = lua_gettop(lua_state) - 1;
-            LuaParameters results = get_lua_parameters(lua_state, 2);
-
-            lua_pop(lua_state, num_results + 1);
+            const auto results = read_bridge_values(lua_state, base + 1, arena, nested_results);
+            lua_settop(lua_state, base);
 
             return results;
         } catch (const std::exception &e) {
+            lua_settop(lua_state, base);
             return std::unexpected(std::format("Exception calling Luau function: {}", e.what()));
         }
     }
 
+    BridgeResult<std::shared_ptr<BridgeCallToken> > BridgeProvider::call_luau_function_async(
+        const std::string_view mod_name,
+        const std::string_view function_name,
+        LuaParameters parameters,
+        AsyncCallCallback on_complete) {
+        if (mod_name.empty() || function_name.empty()) {
+            return std::unexpected("Mod name and function name cannot be empty");
+        }
+
+        return enqueue_async_call(get_luau_function_slot(mod_name, function_name), std::move(parameters),
+                                  std::move(on_complete));
+    }
+
+    BridgeResult<std::shared_ptr<BridgeCallToken> > BridgeProvider::enqueue_async_call(
+        std::shared_ptr<LuauFunctionSlot> slot, LuaParameters parameters, AsyncCallCallback on_complete) {
+        auto token = std::make_shared<BridgeCallToken>();
+
+        if (!async_calls.try_push(AsyncCall{
+            .slot = std::move(slot),
+            .parameters = std::move(parameters),
+            .token = token,
+            .on_complete = std::move(on_complete)
+        })) {
+            return std::unexpected("Async bridge call queue is full");
+        }
+
+        return token;
+    }
+
+    std::size_t BridgeProvider::drain_async_calls(lua_State *L, const std::size_t max_calls) noexcept {
+        if (async_calls.empty_approx() || !L) {
+            return 0;
+        }
+
+        // Single consumer; another DataModel's job may be stepping at the same time
+        if (async_drain_flag.test_and_set(std::memory_order_acquire)) {
+            return 0;
+        }
+
+        std::size_t executed = 0;
+
+        if (const auto state = get_lua_state(); state && lua_mainthread(state) == lua_mainthread(L)) {
+            // One arena for the whole batch, reset between calls
+            BridgeArena arena;
+
+            while (executed < max_calls) {
+                auto call = async_calls.try_pop();
+                if (!call) {
+                    break;
+                }
+
+                ++executed;
+
+                BridgeResult<LuaParameters> result;
+                try {
+                    arena.reset();
+                    const auto results = call_luau_slot(*call->slot, from_lua_parameters(call->parameters, arena),
+                                                        arena, false);
+                    result = results
+                                 ? BridgeResult<LuaParameters>(to_lua_parameters(*results))
+                                 : std::unexpected(results.error());
+                } catch (const std::exception &e) {
+                    result = std::unexpected(std::format("Exception calling Luau function: {}", e.what()));
+                }
+
+                call->token->complete(std::move(result));
+
+                if (call->on_complete) {
+                    try {
+                        call->on_complete(call->token->result());
+                    } catch (const std::exception &e) {
+                        LOG_ERROR("Bridge: Async call completion handler for '{}.{}' failed: {}",
+                                  call->slot->mod_name, call->slot->function_name, e.what());
+                    }
+                }
+            }
+        }
+
+        async_drain_flag.clear(std::memory_order_release);
+        return executed;
+    }
+
+    void BridgeProvider::cache_luau_function(lua_State *L, const std::string_view mod_name,
+                                             const std::string_view function_name, const int index) {
+        const auto slot = get_luau_function_slot(mod_name, function_name);
+        const auto main_thread = lua_mainthread(L);
+        const int ref = lua_ref(L, index);
+
+        std::lock_guard lock(luau_functions_mutex);
+        if (slot->ref != LUA_NOREF && slot->owner == main_thread) {
+            lua_unref(L, slot->ref);
+        }
+        slot->owner = main_thread;
+        slot->ref = ref;
+    }
+
+    void BridgeProvider::invalidate_luau_functions(const std::string_view mod_name) noexcept {
+        try {
+            // References into a state other than the live one are dropped without touching it; it may be gone
+            const auto live_state = get_lua_state();
+            const auto live_main_thread = live_state ? lua_mainthread(live_state) : nullptr;
+
+            std::size_t invalidated = 0;
+            std::lock_guard lock(luau_functions_mutex);
+            for (const auto &slot: luau_functions | std::views::values) {
+                if (slot->mod_name != mod_name || slot->ref == LUA_NOREF) {
+                    continue;
+                }
+
+                if (slot->owner == live_main_thread) {
+                    lua_unref(live_state, slot->ref);
+                }
+                slot->owner = nullptr;
+                slot->ref = LUA_NOREF;
+                ++invalidated;
+            }
+
+            if (invalidated > 0) {
+                LOG_DEBUG("Bridge: Invalidated {} cached functions of mod '{}'", invalidated, mod_name);
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Bridge: Failed to invalidate functions of mod '{}': {}", mod_name, e.what());
+        }
+    }
+
     BridgeResult<void> BridgeProvider::set_shared_data(std::string_view key, const LuaValue &value) {
         if (key.empty()) {
             return std::unexpected("Key cannot be empty");
         }
 
-        std::unique_lock lock(mutex);
-        shared_data[std::string(key)] = value;
+        shared_data.set(key, value);
         return {};
     }
 
@@ -152,14 +483,62 @@ namespace rml::luau::environment {
             return std::unexpected("Key cannot be empty");
         }
 
-        std::shared_lock lock(mutex);
-        const auto it = shared_data.find(std::string(key));
-        return it != shared_data.end() ? it->second : LuaValue{nullptr};
+        return *shared_data.get(key).value;
+    }
+
+    BridgeResult<SharedDataSnapshot> BridgeProvider::get_shared_data_snapshot(const std::string_view key) const {
+        if (key.empty()) {
+            return std::unexpected("Key cannot be empty");
+        }
+
+        return shared_data.get(key);
+    }
+
+    BridgeResult<std::size_t> BridgeProvider::subscribe_shared_data(const std::string_view key,
+                                                                    SharedDataCallback callback) {
+        if (!callback) {
+            return std::unexpected("Callback cannot be empty");
+        }
+
+        try {
+            return shared_data.subscribe(key, std::move(callback));
+        } catch (const std::exception &e) {
+            return std::unexpected(std::format("Failed to subscribe to shared data: {}", e.what()));
+        }
+    }
+
+    void BridgeProvider::unsubscribe_shared_data(const std::size_t subscription_id) {
+        shared_data.unsubscribe(subscription_id);
+    }
+
+    std::size_t BridgeProvider::dispatch_shared_data_changes(lua_State *L) noexcept {
+        if (!L || !shared_data.has_pending_changes()) {
+            return 0;
+        }
+
+        // Lua subscribers run on the bridge's state, so other DataModels leave the changes for it
+        if (const auto state = get_lua_state(); !state || lua_mainthread(state) != lua_mainthread(L)) {
+            return 0;
+        }
+
+        return shared_data.dispatch_changes();
     }
 
     BridgeResult<std::unique_ptr<EventListenerHandle> > BridgeProvider::listen_event(
         const std::string_view event_name,
         EventCallback callback) {
+        if (!callback) {
+            return std::unexpected("Callback cannot be empty");
+        }
+
+        return listen_event_values(event_name, [callback = std::move(callback)](const BridgeValues data) {
+            callback(to_lua_parameters(data));
+        });
+    }
+
+    BridgeResult<std::unique_ptr<EventListenerHandle> > BridgeProvider::listen_event_values(
+        const std::string_view event_name,
+        EventValueCallback callback) {
         if (event_name.empty()) {
             return std::unexpected("Event name cannot be empty");
         }
@@ -173,7 +552,26 @@ namespace rml::luau::environment {
             return std::unexpected("Event name cannot be empty");
         }
 
-        for (auto listeners = get_event_listeners(std::string(event_name)); const auto &[id, callback]: listeners) {
+        if (!get_event_listeners(event_name)) {
+            return {};
+        }
+
+        BridgeArena arena;
+        return trigger_event_values(event_name, from_lua_parameters(data, arena));
+    }
+
+    BridgeResult<void> BridgeProvider::trigger_event_values(const std::string_view event_name,
+                                                            const BridgeValues data) {
+        if (event_name.empty()) {
+            return std::unexpected("Event name cannot be empty");
+        }
+
+        const auto listeners = get_event_listeners(event_name);
+        if (!listeners) {
+            return {};
+        }
+
+        for (const auto &[id, callback]: *listeners) {
             try {
                 callback(data);
             } catch (const std::exception &e) {
@@ -214,10 +612,13 @@ namespace rml::luau::environment {
         return functions;
     }
 
-    NativeFunctionCallback BridgeProvider::get_native_function(const std::string &full_name) {
-        std::shared_lock lock(mutex);
-        const auto it = native_functions.find(full_name);
-        return it != native_functions.end() ? it->second : NativeFunctionCallback{};
+    std::shared_ptr<const NativeValueCallback> BridgeProvider::get_native_function(
+        const std::string_view mod_name, const std::string_view function_name) const {
+        return with_full_name(mod_name, function_name, [this](const std::string_view full_name) {
+            std::shared_lock lock(mutex);
+            const auto it = native_functions.find(full_name);
+            return it != native_functions.end() ? it->second : nullptr;
+        });
     }
 
     bool BridgeProvider::has_native_function(const std::string &full_name) const {
@@ -225,26 +626,134 @@ namespace rml::luau::environment {
         return native_functions.contains(full_name);
     }
 
-    size_t BridgeProvider::add_event_listener(const std::string &event_name, EventCallback callback) {
-        std::unique_lock lock(mutex);
+    size_t BridgeProvider::add_event_listener(const std::string &event_name, EventValueCallback callback) {
+        std::lock_guard lock(event_listeners_mutex);
         const size_t id = next_listener_id++;
-        event_listeners[event_name].push_back({id, std::move(callback)});
+
+        auto listeners = std::make_shared<std::vector<EventListener> >();
+        auto map = std::make_shared<EventListenerMap>(*event_listeners.load(std::memory_order_acquire));
+        if (const auto it = map->find(event_name); it != map->end()) {
+            listeners->reserve(it->second->size() + 1);
+            listeners->assign(it->second->begin(), it->second->end());
+        }
+        listeners->push_back({id, std::move(callback)});
+
+        (*map)[event_name] = std::move(listeners);
+        event_listeners.store(std::move(map), std::memory_order_release);
         return id;
     }
 
     void BridgeProvider::remove_event_listener(const std::string &event_name, size_t listener_id) {
-        std::unique_lock lock(mutex);
-        if (const auto it = event_listeners.find(event_name); it != event_listeners.end()) {
-            auto &listeners = it->second;
-            std::erase_if(listeners,
-                          [listener_id](const EventListener &l) { return l.id == listener_id; });
+        std::lock_guard lock(event_listeners_mutex);
+        const auto current = event_listeners.load(std::memory_order_acquire);
+
+        const auto it = current->find(event_name);
+        if (it == current->end() || std::ranges::none_of(*it->second, [listener_id](const EventListener &l) {
+            return l.id == listener_id;
+        })) {
+            return;
         }
+
+        auto listeners = std::make_shared<std::vector<EventListener> >();
+        listeners->reserve(it->second->size() - 1);
+        std::ranges::copy_if(*it->second, std::back_inserter(*listeners),
+                             [listener_id](const EventListener &l) { return l.id != listener_id; });
+
+        auto map = std::make_shared<EventListenerMap>(*current);
+        if (listeners->empty()) {
+            map->erase(event_name);
+        } else {
+            (*map)[event_name] = std::move(listeners);
+        }
+        event_listeners.store(std::move(map), std::memory_order_release);
     }
 
-    std::vector<EventListener> BridgeProvider::get_event_listeners(const std::string &event_name) {
-        std::shared_lock lock(mutex);
-        const auto it = event_listeners.find(event_name);
-        return it != event_listeners.end() ? it->second : std::vector<EventListener>{};
+    void BridgeProvider::track_lua_callback(LuaCallbackRegistration registration) {
+        std::lock_guard lock(lua_callbacks_mutex);
+        lua_callbacks.push_back(std::move(registration));
+    }
+
+    bool BridgeProvider::release_lua_callback(const LuaCallbackRegistration::Kind kind, const size_t id) noexcept {
+        try {
+            std::optional<LuaCallbackRegistration> released;
+            {
+                std::lock_guard lock(lua_callbacks_mutex);
+                const auto it = std::ranges::find_if(lua_callbacks, [kind, id](const LuaCallbackRegistration &r) {
+                    return r.kind == kind && r.id == id;
+                });
+                if (it == lua_callbacks.end()) {
+                    return false;
+                }
+
+                released = std::move(*it);
+                lua_callbacks.erase(it);
+            }
+
+            drop_lua_callbacks({&*released, 1});
+            return true;
+        } catch (const std::exception &e) {
+            LOG_ERROR("Bridge: Failed to release Luau callback {}: {}", id, e.what());
+            return false;
+        }
+    }
+
+    void BridgeProvider::release_lua_callbacks(const std::string_view mod_name) noexcept {
+        try {
+            std::vector<LuaCallbackRegistration> released;
+            {
+                std::lock_guard lock(lua_callbacks_mutex);
+                const auto removed = std::ranges::partition(lua_callbacks,
+                                                            [mod_name](const LuaCallbackRegistration &r) {
+                                                                return r.mod_name != mod_name;
+                                                            });
+                std::ranges::move(removed, std::back_inserter(released));
+                lua_callbacks.erase(removed.begin(), removed.end());
+            }
+
+            if (released.empty()) {
+                return;
+            }
+
+            drop_lua_callbacks(released);
+            LOG_DEBUG("Bridge: Released {} Luau callbacks of mod '{}'", released.size(), mod_name);
+        } catch (const std::exception &e) {
+            LOG_ERROR("Bridge: Failed to release callbacks of mod '{}': {}", mod_name, e.what());
+        }
+    }
+
+    void BridgeProvider::drop_lua_callbacks(const std::span<const LuaCallbackRegistration> registrations) noexcept {
+        try {
+            // As with cached functions, references into a state other than the live one are left alone
+            const auto live_state = get_lua_state();
+            const auto live_main_thread = live_state ? lua_mainthread(live_state) : nullptr;
+
+            for (const auto &registration: registrations) {
+                if (registration.kind == LuaCallbackRegistration::Kind::DataWatch) {
+                    shared_data.unsubscribe(registration.id);
+                } else {
+                    remove_event_listener(registration.event_name, registration.id);
+                }
+
+                // A snapshot taken before the removal may still call it; it finds it dead and returns
+                registration.refs->alive.store(false, std::memory_order_release);
+                if (registration.refs->owner == live_main_thread) {
+                    registration.refs->release_in = live_state;
+                }
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Bridge: Failed to drop Luau callbacks: {}", e.what());
+        }
+    }
+
+    EventListenerSnapshot BridgeProvider::get_event_listeners(const std::string_view event_name) const noexcept {
+        auto map = event_listeners.load(std::memory_order_acquire);
+        const auto it = map->find(event_name);
+        if (it == map->end()) {
+            return {};
+        }
+
+        // Shares ownership of the map snapshot, which keeps the list alive, without another reference count
+        return EventListenerSnapshot(std::move(map), it->second.get());
     }
 
     BridgeProvider *BridgeProvider::instance() {
@@ -270,6 +779,10 @@ namespace rml::luau::environment {
             lua_setfield(L, -2, "set_data");
             lua_pushcfunction(L, lua_bridge_impl::get_data, "get_data");
             lua_setfield(L, -2, "get_data");
+            lua_pushcfunction(L, lua_bridge_impl::watch_data, "watch_data");
+            lua_setfield(L, -2, "watch_data");
+            lua_pushcfunction(L, lua_bridge_impl::unwatch_data, "unwatch_data");
+            lua_setfield(L, -2, "unwatch_data");
             lua_pushcfunction(L, lua_bridge_impl::listen_event, "listen_event");
             lua_setfield(L, -2, "listen_event");
             lua_pushcfunction(L, lua_bridge_impl::trigger_event, "trigger_event");
@@ -382,6 +895,104 @@ namespace rml::luau::environment {
         }
     }
 
+    LuaValue BridgeProvider::to_lua_value(const BridgeValue &value) {
+        switch (value.kind()) {
+            case BridgeValue::Kind::String:
+                return std::string(value.as_string());
+            case BridgeValue::Kind::Number:
+                return value.as_number();
+            case BridgeValue::Kind::Boolean:
+                return value.as_boolean();
+            case BridgeValue::Kind::Table: {
+                LuaTable table;
+                for (const auto &[key, field_value]: value.as_table()) {
+                    if (key.kind() != BridgeValue::Kind::String) {
+                        continue;
+                    }
+
+                    switch (field_value.kind()) {
+                        case BridgeValue::Kind::String:
+                            table.set(std::string(key.as_string()), std::string(field_value.as_string()));
+                            break;
+                        case BridgeValue::Kind::Number:
+                            table.set(std::string(key.as_string()), field_value.as_number());
+                            break;
+                        case BridgeValue::Kind::Boolean:
+                            table.set(std::string(key.as_string()), field_value.as_boolean());
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                return table;
+            }
+            case BridgeValue::Kind::Array:
+                return LuaTable{};
+            case BridgeValue::Kind::Nil:
+            default:
+                return nullptr;
+        }
+    }
+
+    LuaParameters BridgeProvider::to_lua_parameters(const BridgeValues values) {
+        LuaParameters params;
+        params.reserve(values.size());
+
+        for (const auto &value: values) {
+            params.push_back(to_lua_value(value));
+        }
+
+        return params;
+    }
+
+    BridgeValue BridgeProvider::from_lua_value(const LuaValue &value, BridgeArena &arena) {
+        return std::visit([&arena]<typename Type>(const Type &v) -> BridgeValue {
+            using T = std::decay_t<Type>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                return BridgeValue::string(v, arena);
+            } else if constexpr (std::is_same_v<T, double>) {
+                return BridgeValue::number(v);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                return BridgeValue::boolean(v);
+            } else if constexpr (std::is_same_v<T, LuaTable>) {
+                auto *fields = arena.allocate_array<BridgeField>(v.size());
+                std::size_t filled = 0;
+
+                for (const auto &[key, table_value]: v) {
+                    const auto field_value = std::visit([&arena]<typename TableType>(const TableType &tv) {
+                        using TT = std::decay_t<TableType>;
+                        if constexpr (std::is_same_v<TT, std::string>) {
+                            return BridgeValue::string(tv, arena);
+                        } else if constexpr (std::is_same_v<TT, double>) {
+                            return BridgeValue::number(tv);
+                        } else if constexpr (std::is_same_v<TT, bool>) {
+                            return BridgeValue::boolean(tv);
+                        } else {
+                            return BridgeValue{};
+                        }
+                    }, table_value);
+
+                    if (!field_value.is_nil()) {
+                        fields[filled++] = BridgeField{BridgeValue::string(key, arena), field_value};
+                    }
+                }
+
+                return BridgeValue::table({fields, filled});
+            } else {
+                return {};
+            }
+        }, value);
+    }
+
+    BridgeValues BridgeProvider::from_lua_parameters(const LuaParameters &parameters, BridgeArena &arena) {
+        auto *values = arena.allocate_array<BridgeValue>(parameters.size());
+        for (std::size_t i = 0; i < parameters.size(); ++i) {
+            values[i] = from_lua_value(parameters[i], arena);
+        }
+
+        return {values, parameters.size()};
+    }
+
     namespace lua_bridge_impl {
         int call_native_function(lua_State *L) {
             try {
@@ -389,19 +1000,18 @@ namespace rml::luau::environment {
                     luaL_error(L, "callNative requires at least 2 arguments: mod_name, function_name");
                 }
 
-                std::string mod_name = luaL_checkstring(L, 1);
-                std::string function_name = luaL_checkstring(L, 2);
-                const std::string full_name = std::format("{}.{}", mod_name, function_name);
+                const std::string_view mod_name = luaL_checkstring(L, 1);
+                const std::string_view function_name = luaL_checkstring(L, 2);
 
-                const auto callback = BridgeProvider::instance()->get_native_function(full_name);
+                const auto callback = BridgeProvider::instance()->get_native_function(mod_name, function_name);
                 if (!callback) {
-                    luaL_error(L, "Native function '%s' not found", full_name.c_str());
+                    luaL_error(L, "Native function '%s.%s' not found", mod_name.data(), function_name.data());
                 }
 
-                const LuaParameters params = BridgeProvider::get_lua_parameters(L, 3);
-
-                const LuaParameters results = callback(params);
-                BridgeProvider::push_lua_parameters(L, results);
+                // Arguments and results live in the arena, so a small call never allocates
+                BridgeArena arena;
+                const auto results = (*callback)(read_bridge_values(L, 3, arena), arena);
+                push_bridge_values(L, results);
 
                 return static_cast<int>(results.size());
             } catch (const std::exception &e) {
@@ -434,6 +1044,9 @@ namespace rml::luau::environment {
                 lua_setfield(L, -2, function_name.c_str());
                 lua_pop(L, 1);
 
+                // The table above is in the caller's sandboxed env; bridge calls use the cached reference
+                BridgeProvider::instance()->cache_luau_function(L, mod_name, function_name, 3);
+
                 return 0;
             } catch (const std::exception &e) {
                 luaL_error(L, "Error registering Luau function: %s", e.what());
@@ -451,11 +1064,8 @@ namespace rml::luau::environment {
                     luaL_error(L, "BridgeProvider instance not available");
                 }
 
-                const std::string key = luaL_checkstring(L, 1);
-                const LuaValue value = BridgeProvider::lua_to_value(L, 2);
-
-                std::unique_lock lock(bridge->mutex);
-                bridge->shared_data[key] = value;
+                const std::string_view key = luaL_checkstring(L, 1);
+                bridge->shared_data.set(key, BridgeProvider::lua_to_value(L, 2));
                 return 0;
             } catch (const std::exception &e) {
                 luaL_error(L, "Error setting data: %s", e.what());
@@ -468,21 +1078,84 @@ namespace rml::luau::environment {
                     luaL_error(L, "getData requires 1 argument: key");
                 }
 
-                const std::string key = luaL_checkstring(L, 1);
+                const std::string_view key = luaL_checkstring(L, 1);
 
-                std::shared_lock lock(BridgeProvider::instance()->mutex);
-                const auto it = BridgeProvider::instance()->shared_data.find(key);
-                const LuaValue value = it != BridgeProvider::instance()->shared_data.end()
-                                           ? it->second
-                                           : LuaValue{nullptr};
+                // Holds the stored value rather than a copy of it
+                const auto snapshot = BridgeProvider::instance()->shared_data.get(key);
 
-                BridgeProvider::value_to_lua(L, value);
-                return 1;
+                BridgeProvider::value_to_lua(L, *snapshot.value);
+                lua_pushnumber(L, static_cast<double>(snapshot.version));
+                return 2;
             } catch (const std::exception &e) {
                 luaL_error(L, "Error getting data: %s", e.what());
             }
         }
 
+        int watch_data(lua_State *L) {
+            try {
+                if (lua_gettop(L) < 2) {
+                    luaL_error(L, "watchData requires 2 arguments: key, callback");
+                }
+
+                const std::string_view key = luaL_checkstring(L, 1);
+
+                if (!lua_isfunction(L, 2)) {
+                    luaL_error(L, "Second argument must be a function");
+                }
+
+                const auto refs = anchor_callback(L, 2);
+
+                const SharedDataCallback callback = [refs](const std::string_view changed_key,
+                                                           const SharedDataSnapshot &snapshot) {
+                    if (!refs->alive.load(std::memory_order_acquire)) {
+                        return;
+                    }
+
+                    const auto callback_thread = refs->thread;
+                    lua_rawgeti(callback_thread, LUA_REGISTRYINDEX, refs->callback_ref);
+                    lua_pushlstring(callback_thread, changed_key.data(), changed_key.size());
+                    BridgeProvider::value_to_lua(callback_thread, *snapshot.value);
+                    lua_pushnumber(callback_thread, static_cast<double>(snapshot.version));
+
+                    if (lua_pcall(callback_thread, 3, 0, 0) != LUA_OK) {
+                        LOG_ERROR("Bridge: Error in shared data callback: {}", lua_tostring(callback_thread, -1));
+                        lua_pop(callback_thread, 1);
+                    }
+                };
+
+                const auto bridge = BridgeProvider::instance();
+                const auto id = bridge->shared_data.subscribe(key, callback);
+
+                // Dropped by unwatch_data, or when the mod reloads
+                bridge->track_lua_callback(LuaCallbackRegistration{
+                    .kind = LuaCallbackRegistration::Kind::DataWatch,
+                    .mod_name = running_mod_name(L),
+                    .id = id,
+                    .refs = refs
+                });
+                lua_pushinteger(L, static_cast<lua_Integer>(id));
+
+                return 1;
+            } catch (const std::exception &e) {
+                luaL_error(L, "Error watching data: %s", e.what());
+            }
+        }
+
+        int unwatch_data(lua_State *L) {
+            try {
+                const auto id = static_cast<std::size_t>(luaL_checkinteger(L, 1));
+
+                // Subscriptions made by watch_data also drop the references it took
+                const auto bridge = BridgeProvider::instance();
+                if (!bridge->release_lua_callback(LuaCallbackRegistration::Kind::DataWatch, id)) {
+                    bridge->shared_data.unsubscribe(id);
+                }
+                return 0;
+            } catch (const std::exception &e) {
+                luaL_error(L, "Error unwatching data: %s", e.what());
+            }
+        }
+
         int listen_event(lua_State *L) {
             try {
                 if (lua_gettop(L) < 2) {
@@ -495,19 +1168,34 @@ namespace rml::luau::environment {
                     luaL_error(L, "Second argument must be a function");
                 }
 
-                int callback_ref = lua_ref(L, 1);
+                const auto refs = anchor_callback(L, 2);
 
-                const EventCallback callback = [L, callback_ref](const LuaParameters &params) {
-                    lua_rawgeti(L, LUA_REGISTRYINDEX, callback_ref);
-                    BridgeProvider::push_lua_parameters(L, params);
+                const EventValueCallback callback = [refs](const BridgeValues params) {
+                    if (!refs->alive.load(std::memory_order_acquire)) {
+                        return;
+                    }
 
-                    if (lua_pcall(L, static_cast<int>(params.size()), 0, 0) != LUA_OK) {
-                        LOG_ERROR("Bridge: Error in event callback: {}", lua_tostring(L, -1));
-                        lua_pop(L, 1);
+                    const auto callback_thread = refs->thread;
+                    lua_rawgeti(callback_thread, LUA_REGISTRYINDEX, refs->callback_ref);
+                    push_bridge_values(callback_thread, params);
+
+                    if (lua_pcall(callback_thread, static_cast<int>(params.size()), 0, 0) != LUA_OK) {
+                        LOG_ERROR("Bridge: Error in event callback: {}", lua_tostring(callback_thread, -1));
+                        lua_pop(callback_thread, 1);
                     }
                 };
 
-                const size_t listener_id = BridgeProvider::instance()->add_event_listener(event_name, callback);
+                const auto bridge = BridgeProvider::instance();
+                const size_t listener_id = bridge->add_event_listener(event_name, callback);
+
+                // Removed again when the mod reloads; a re-run script registers its listeners anew
+                bridge->track_lua_callback(LuaCallbackRegistration{
+                    .kind = LuaCallbackRegistration::Kind::EventListener,
+                    .mod_name = running_mod_name(L),
+                    .event_name = event_name,
+                    .id = listener_id,
+                    .refs = refs
+                });
                 lua_pushinteger(L, static_cast<lua_Integer>(listener_id));
 
                 return 1;
@@ -522,11 +1210,17 @@ namespace rml::luau::environment {
                     luaL_error(L, "triggerEvent requires at least 1 argument: event_name");
                 }
 
-                const std::string event_name = luaL_checkstring(L, 1);
-                const LuaParameters params = BridgeProvider::get_lua_parameters(L, 2);
+                const std::string_view event_name = luaL_checkstring(L, 1);
+
+                const auto listeners = BridgeProvider::instance()->get_event_listeners(event_name);
+                if (!listeners) {
+                    return 0;
+                }
+
+                BridgeArena arena;
+                const auto params = read_bridge_values(L, 2, arena);
 
-                for (const auto listeners = BridgeProvider::instance()->get_event_listeners(event_name); const auto &[id
-                         , callback]: listeners) {
+                for (const auto &[id, callback]: *listeners) {
                     try {
                         callback(params);
                     } catch (const std::exception &e) {
@@ -0,0 +1,300 @@
+#include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/luau/environment/bridge_value.hpp"
+#include <unordered_map>
+
+namespace rml::luau::environment {
+    namespace {
+        // Bounds the recursion; cycles are reported as such before this is reached
+        constexpr int MAX_DEPTH = 32;
+
+        // Tables of one read. Those on the path to the current one are open, and meeting one of them again is a
+        // cycle. Finished ones are shared when referenced again instead of being copied.
+        struct ReadState {
+            BridgeArena &arena;
+            bool nested;
+            std::array<const void *, MAX_DEPTH> open{};
+            std::optional<std::unordered_map<const void *, BridgeValue> > finished; // Made by the first table
+        };
+
+        BridgeValue read_value(lua_State *L, int index, ReadState &state, int depth);
+
+        BridgeValue read_key(lua_State *L, const int index, BridgeArena &arena) {
+            switch (lua_type(L, index)) {
+                case LUA_TSTRING: {
+                    std::size_t length = 0;
+                    const char *data = lua_tolstring(L, index, &length);
+                    return BridgeValue::string({data, length}, arena);
+                }
+                case LUA_TNUMBER:
+                    return BridgeValue::number(lua_tonumber(L, index));
+                case LUA_TBOOLEAN:
+                    return BridgeValue::boolean(lua_toboolean(L, index));
+                default:
+                    return {};
+            }
+        }
+
+        BridgeValue read_table_contents(lua_State *L, const int index, ReadState &state, const int depth) {
+            lua_checkstack(L, 3);
+
+            std::size_t count = 0;
+            lua_pushnil(L);
+            while (lua_next(L, index)) {
+                ++count;
+                lua_pop(L, 1);
+            }
+
+            // A sequence with nothing else in it
+            if (const auto length = static_cast<std::size_t>(lua_objlen(L, index)); length > 0 && length == count) {
+                auto *items = state.arena.allocate_array<BridgeValue>(length);
+                for (std::size_t i = 0; i < length; ++i) {
+                    lua_rawgeti(L, index, static_cast<int>(i + 1));
+                    items[i] = read_value(L, lua_gettop(L), state, depth + 1);
+                    lua_pop(L, 1);
+                }
+                return BridgeValue::array({items, length});
+            }
+
+            auto *fields = state.arena.allocate_array<BridgeField>(count);
+            std::size_t filled = 0;
+
+            lua_pushnil(L);
+            while (lua_next(L, index)) {
+                const auto key = read_key(L, -2, state.arena);
+                if (!key.is_nil()) {
+                    if (const auto value = read_value(L, lua_gettop(L), state, depth + 1); !value.is_nil()) {
+                        fields[filled++] = BridgeField{key, value};
+                    }
+                }
+                lua_pop(L, 1);
+            }
+
+            return BridgeValue::table({fields, filled});
+        }
+
+        BridgeValue read_table(lua_State *L, const int index, ReadState &state, const int depth) {
+            if (!state.nested && depth > 0) {
+                return {};
+            }
+
+            const void *table = lua_topointer(L, index);
+            if (std::ranges::find(state.open.begin(), state.open.begin() + depth, table) !=
+                state.open.begin() + depth) {
+                throw std::runtime_error("Bridge value contains a cyclic table");
+            }
+
+            if (state.finished) {
+                if (const auto it = state.finished->find(table); it != state.finished->end()) {
+                    return it->second; // Points at the same arena storage
+                }
+            }
+
+            if (depth >= MAX_DEPTH) {
+                throw std::runtime_error("Bridge value is nested too deeply");
+            }
+
+            state.open[depth] = table;
+            const auto value = read_table_contents(L, index, state, depth);
+
+            if (!state.finished) {
+                state.finished.emplace();
+            }
+            state.finished->emplace(table, value);
+            return value;
+        }
+
+        BridgeValue read_value(lua_State *L, const int index, ReadState &state, const int depth) {
+            switch (lua_type(L, index)) {
+                case LUA_TTABLE:
+                    return read_table(L, index, state, depth);
+                case LUA_TSTRING:
+                case LUA_TNUMBER:
+                case LUA_TBOOLEAN:
+                    return read_key(L, index, state.arena);
+                case LUA_TNIL:
+                default:
+                    return {};
+            }
+        }
+    }
+
+    void *BridgeArena::allocate(const std::size_t size, const std::size_t alignment) {
+        auto address = reinterpret_cast<std::uintptr_t>(m_cursor);
+        auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+        if (aligned + size > reinterpret_cast<std::uintptr_t>(m_end)) {
+            const auto block_size = std::max(m_next_block_size, size + alignment);
+            auto &block = m_blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(block_size));
+            m_cursor = block.get();
+            m_end = m_cursor + block_size;
+            m_next_block_size = block_size * 2;
+
+            address = reinterpret_cast<std::uintptr_t>(m_cursor);
+            aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        }
+
+        m_cursor += aligned - address + size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    void BridgeArena::reset() noexcept {
+        m_blocks.clear();
+        m_cursor = m_inline;
+        m_end = m_inline + INLINE_CAPACITY;
+    }
+
+    BridgeValue BridgeValue::boolean(const bool value) noexcept {
+        BridgeValue result;
+        result.m_boolean = value;
+        result.m_kind = Kind::Boolean;
+        return result;
+    }
+
+    BridgeValue BridgeValue::number(const double value) noexcept {
+        BridgeValue result;
+        result.m_number = value;
+        result.m_kind = Kind::Number;
+        return result;
+    }
+
+    BridgeValue BridgeValue::string(const std::string_view value, BridgeArena &arena) {
+        BridgeValue result;
+        result.m_kind = Kind::String;
+
+        if (value.size() <= SMALL_STRING_CAPACITY) {
+            std::memcpy(result.m_small, value.data(), value.size());
+            result.m_small_size = static_cast<std::uint8_t>(value.size());
+            return result;
+        }
+
+        auto *data = arena.allocate_array<char>(value.size());
+        std::memcpy(data, value.data(), value.size());
+        result.m_string = {data, static_cast<std::uint32_t>(value.size())};
+        result.m_small_size = UINT8_MAX; // Marks the string as out of line
+        return result;
+    }
+
+    BridgeValue BridgeValue::array(const std::span<const BridgeValue> items) noexcept {
+        BridgeValue result;
+        result.m_array = {items.data(), static_cast<std::uint32_t>(items.size())};
+        result.m_kind = Kind::Array;
+        return result;
+    }
+
+    BridgeValue BridgeValue::table(const std::span<const BridgeField> fields) noexcept {
+        BridgeValue result;
+        result.m_table = {fields.data(), static_cast<std::uint32_t>(fields.size())};
+        result.m_kind = Kind::Table;
+        return result;
+    }
+
+    bool BridgeValue::as_boolean() const noexcept {
+        return m_kind == Kind::Boolean && m_boolean;
+    }
+
+    double BridgeValue::as_number() const noexcept {
+        return m_kind == Kind::Number ? m_number : 0.0;
+    }
+
+    std::string_view BridgeValue::as_string() const noexcept {
+        if (m_kind != Kind::String) {
+            return {};
+        }
+        return m_small_size == UINT8_MAX
+                   ? std::string_view(m_string.data, m_string.size)
+                   : std::string_view(m_small, m_small_size);
+    }
+
+    std::span<const BridgeValue> BridgeValue::as_array() const noexcept {
+        return m_kind == Kind::Array ? std::span(m_array.data, m_array.size) : std::span<const BridgeValue>{};
+    }
+
+    std::span<const BridgeField> BridgeValue::as_table() const noexcept {
+        return m_kind == Kind::Table ? std::span(m_table.data, m_table.size) : std::span<const BridgeField>{};
+    }
+
+    const BridgeValue *BridgeValue::find(const std::string_view key) const noexcept {
+        for (const auto &field: as_table()) {
+            if (field.key.kind() == Kind::String && field.key.as_string() == key) {
+                return &field.value;
+            }
+        }
+        return nullptr;
+    }
+
+    BridgeValues read_bridge_values(lua_State *L, const int start_index, BridgeArena &arena, const bool nested) {
+        const int top = lua_gettop(L);
+        if (top < start_index) {
+            return {};
+        }
+
+        ReadState state{.arena = arena, .nested = nested};
+        const auto count = static_cast<std::size_t>(top - start_index + 1);
+        auto *values = arena.allocate_array<BridgeValue>(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = read_value(L, start_index + static_cast<int>(i), state, 0);
+        }
+
+        return {values, count};
+    }
+
+    BridgeValue read_bridge_value(lua_State *L, int index, BridgeArena &arena, const bool nested) {
+        if (index < 0 && index > LUA_REGISTRYINDEX) {
+            index = lua_gettop(L) + index + 1; // Table reads push onto the stack
+        }
+
+        ReadState state{.arena = arena, .nested = nested};
+        return read_value(L, index, state, 0);
+    }
+
+    void push_bridge_value(lua_State *L, const BridgeValue &value) {
+        switch (value.kind()) {
+            case BridgeValue::Kind::Boolean:
+                lua_pushboolean(L, value.as_boolean());
+                break;
+            case BridgeValue::Kind::Number:
+                lua_pushnumber(L, value.as_number());
+                break;
+            case BridgeValue::Kind::String: {
+                const auto string = value.as_string();
+                lua_pushlstring(L, string.data(), string.size());
+                break;
+            }
+            case BridgeValue::Kind::Array: {
+                const auto items = value.as_array();
+                lua_checkstack(L, 2);
+                lua_createtable(L, static_cast<int>(items.size()), 0);
+                for (std::size_t i = 0; i < items.size(); ++i) {
+                    push_bridge_value(L, items[i]);
+                    lua_rawseti(L, -2, static_cast<int>(i + 1));
+                }
+                break;
+            }
+            case BridgeValue::Kind::Table: {
+                const auto fields = value.as_table();
+                lua_checkstack(L, 3);
+                lua_createtable(L, 0, static_cast<int>(fields.size()));
+                for (const auto &[key, field_value]: fields) {
+                    push_bridge_value(L, key);
+                    push_bridge_value(L, field_value);
+                    lua_rawset(L, -3);
+                }
+                break;
+            }
+            case BridgeValue::Kind::Nil:
+            default:
+                lua_pushnil(L);
+                break;
+        }
+    }
+
+    void push_bridge_values(lua_State *L, const BridgeValues values) {
+        if (!lua_checkstack(L, static_cast<int>(values.size()))) {
+            throw std::runtime_error("Too many bridge values for the Lua stack");
+        }
+
+        for (const auto &value: values) {
+            push_bridge_value(L, value);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/luau/environment/environment_template.hpp"
+
+#include "RobloxModLoader/luau/environment/globals_registry.hpp"
+
+namespace rml::luau::environment {
+    namespace {
+        constexpr auto TEMPLATE_KEY = "rml_environment_template";
+        constexpr auto PROXY_METATABLE_KEY = "rml_environment_proxy";
+
+        // Provider tables nest a couple of levels (rml.bridge, rml.logger, ...)
+        constexpr int FREEZE_DEPTH = 4;
+    }
+
+    bool EnvironmentTemplate::install(lua_State *L) noexcept {
+        if (!L) {
+            return false;
+        }
+
+        // build() leaves the read-only template as L's globals, so L is sandboxed even if a provider failed
+        const bool success = exists(L) || build(L);
+        sandbox_thread(L);
+        return success;
+    }
+
+    void EnvironmentTemplate::sandbox_thread(lua_State *L) noexcept {
+        lua_getfield(L, LUA_REGISTRYINDEX, PROXY_METATABLE_KEY);
+        if (!lua_istable(L, -1)) {
+            lua_pop(L, 1);
+            luaL_sandboxthread(L);
+            return;
+        }
+
+        lua_newtable(L);
+        lua_insert(L, -2);
+        lua_setmetatable(L, -2);
+        lua_replace(L, LUA_GLOBALSINDEX);
+        lua_setsafeenv(L, LUA_GLOBALSINDEX, true);
+    }
+
+    bool EnvironmentTemplate::exists(lua_State *L) noexcept {
+        lua_getfield(L, LUA_REGISTRYINDEX, TEMPLATE_KEY);
+        const bool found = lua_istable(L, -1);
+        lua_pop(L, 1);
+        return found;
+    }
+
+    bool EnvironmentTemplate::build(lua_State *L) noexcept {
+        const auto old_top = lua_gettop(L);
+
+        // Template, reading through to the state's own globals
+        lua_newtable(L);
+        const auto template_index = lua_gettop(L);
+        lua_newtable(L);
+        lua_pushvalue(L, LUA_GLOBALSINDEX);
+        lua_setfield(L, -2, "__index");
+        lua_setreadonly(L, -1, true);
+        lua_setmetatable(L, template_index);
+
+        // Providers register with lua_setglobal, so let them write straight into the template
+        lua_pushvalue(L, template_index);
+        lua_replace(L, LUA_GLOBALSINDEX);
+
+        const bool success = register_all_globals(L);
+        lua_settop(L, template_index);
+
+        freeze(L, template_index, FREEZE_DEPTH);
+
+        lua_newtable(L);
+        lua_pushvalue(L, template_index);
+        lua_setfield(L, -2, "__index");
+        lua_setreadonly(L, -1, true);
+        lua_setfield(L, LUA_REGISTRYINDEX, PROXY_METATABLE_KEY);
+
+        lua_setfield(L, LUA_REGISTRYINDEX, TEMPLATE_KEY);
+
+        lua_settop(L, old_top);
+
+        if (success) {
+            LOG_DEBUG("Built environment template for lua_State: {}", static_cast<void *>(L));
+        } else {
+            LOG_ERROR("Environment template for lua_State {} is missing globals", static_cast<void *>(L));
+        }
+
+        return success;
+    }
+
+    void EnvironmentTemplate::freeze(lua_State *L, const int index, const int depth) noexcept {
+        lua_setreadonly(L, index, true);
+        if (depth == 0) {
+            return;
+        }
+
+        lua_pushnil(L);
+        while (lua_next(L, index)) {
+            // Already read-only tables are either frozen or not ours
+            if (lua_istable(L, -1) && !lua_getreadonly(L, -1)) {
+                freeze(L, lua_gettop(L), depth - 1);
+            }
+            lua_pop(L, 1);
+        }
+    }
+}
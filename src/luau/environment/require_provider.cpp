@@ -1,6 +1,8 @@
 #include "RobloxModLoader/common.hpp"
 #include "RobloxModLoader/luau/environment/require_provider.hpp"
 #include "RobloxModLoader/roblox/task_scheduler.hpp"
+#include "RobloxModLoader/luau/bytecode_cache.hpp"
+#include "RobloxModLoader/luau/mod_package.hpp"
 #include "RobloxModLoader/logger/logger.hpp"
 #include "utils/directory_utils.hpp"
 #include "pointers.hpp"
@@ -12,23 +14,125 @@
 
 namespace rml::luau::environment {
     namespace require_impl {
+        std::shared_ptr<const SharedModule> SharedModuleStore::find(const std::string &resolved_path) const {
+            auto &shard = shard_for(resolved_path);
+            std::shared_lock lock(shard.mutex);
+
+            const auto it = shard.modules.find(resolved_path);
+            return it != shard.modules.end() ? it->second : nullptr;
+        }
+
+        std::shared_ptr<const SharedModule> SharedModuleStore::publish(std::shared_ptr<const SharedModule> module) {
+            auto &shard = shard_for(module->resolved_path);
+            std::unique_lock lock(shard.mutex);
+
+            // Two states compiling the same file race here; keep whichever saw the newer file
+            auto &slot = shard.modules[module->resolved_path];
+            if (!slot || slot->write_time < module->write_time) {
+                if (slot) {
+                    m_epoch.fetch_add(1, std::memory_order_acq_rel);
+                }
+                slot = std::move(module);
+            }
+            return slot;
+        }
+
+        void SharedModuleStore::invalidate(const std::string &resolved_path) {
+            auto &shard = shard_for(resolved_path);
+            std::unique_lock lock(shard.mutex);
+            if (shard.modules.erase(resolved_path) != 0) {
+                m_epoch.fetch_add(1, std::memory_order_acq_rel);
+            }
+        }
+
+        void SharedModuleStore::clear() {
+            for (auto &shard: m_shards) {
+                std::unique_lock lock(shard.mutex);
+                shard.modules.clear();
+            }
+            m_epoch.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        void ModuleGraph::record(const std::string &requirer, const std::string &dependency) {
+            auto normalized_requirer = normalize(requirer);
+            auto normalized_dependency = normalize(dependency);
+
+            std::unique_lock lock(m_mutex);
+            m_dependents[std::move(normalized_dependency)].insert(std::move(normalized_requirer));
+        }
+
+        std::unordered_set<std::string> ModuleGraph::affected_by(
+            const std::vector<std::filesystem::path> &changed) const {
+            std::unordered_set<std::string> affected;
+            std::vector<std::string> pending;
+
+            for (const auto &path: changed) {
+                if (auto normalized = normalize(path); affected.insert(normalized).second) {
+                    pending.push_back(std::move(normalized));
+                }
+            }
+
+            std::shared_lock lock(m_mutex);
+            while (!pending.empty()) {
+                const auto path = std::move(pending.back());
+                pending.pop_back();
+
+                const auto it = m_dependents.find(path);
+                if (it == m_dependents.end()) {
+                    continue;
+                }
+
+                for (const auto &requirer: it->second) {
+                    if (affected.insert(requirer).second) {
+                        pending.push_back(requirer);
+                    }
+                }
+            }
+
+            return affected;
+        }
+
+        void ModuleGraph::clear() {
+            std::unique_lock lock(m_mutex);
+            m_dependents.clear();
+        }
+
+        std::string ModuleGraph::normalize(const std::filesystem::path &path) {
+            std::error_code ec;
+            auto normalized = std::filesystem::weakly_canonical(path, ec);
+            if (ec) {
+                normalized = std::filesystem::absolute(path, ec).lexically_normal();
+            }
+            return normalized.string();
+        }
+
+        namespace {
+            StateCacheShard &shard_for_state(lua_State *L) noexcept {
+                // States are heap allocated, so the low bits carry no information
+                const auto address = reinterpret_cast<std::uintptr_t>(L) >> 6;
+                return g_state_cache_shards[address % g_state_cache_shards.size()];
+            }
+        }
+
         StateCache &get_cache_for_state(lua_State *L) {
-            std::lock_guard lock(g_cache_mutex);
-            return g_state_caches[L];
+            auto &shard = shard_for_state(L);
+            std::lock_guard lock(shard.mutex);
+            return shard.caches[L];
         }
 
         void cleanup_cache_for_state(lua_State *L) {
-            std::lock_guard lock(g_cache_mutex);
-            if (const auto it = g_state_caches.find(L); it != g_state_caches.end()) {
-                for (const auto &ref: it->second.module_cache | std::views::values) {
-                    if (ref != LUA_NOREF) {
-                        lua_unref(L, ref);
+            auto &shard = shard_for_state(L);
+            std::lock_guard lock(shard.mutex);
+            if (const auto it = shard.caches.find(L); it != shard.caches.end()) {
+                for (const auto &cached: it->second.module_cache | std::views::values) {
+                    if (cached.ref != LUA_NOREF) {
+                        lua_unref(L, cached.ref);
                     }
                 }
                 if (it->second.original_require_ref != LUA_NOREF) {
                     lua_unref(L, it->second.original_require_ref);
                 }
-                g_state_caches.erase(it);
+                shard.caches.erase(it);
                 LOG_DEBUG("Cleaned up require cache for lua_State: {}", static_cast<void*>(L));
             }
         }
@@ -89,9 +193,25 @@ namespace rml::luau::environment {
 
             if (const auto cache_it = module_cache.find(module_name);
                 cache_it != module_cache.end()) {
-                lua_rawgeti(L, LUA_REGISTRYINDEX, cache_it->second);
-                LOG_DEBUG("Found cached module '{}' for lua_State: {}", module_name, static_cast<void*>(L));
-                return 1;
+                auto &cached = cache_it->second;
+
+                // Something was invalidated since this value was cached; it's only reusable if its module
+                // is still the published one
+                const auto epoch = require_impl::g_module_store.epoch();
+                if (cached.epoch != epoch &&
+                    require_impl::g_module_store.find(cached.module->resolved_path) == cached.module) {
+                    cached.epoch = epoch;
+                }
+
+                if (cached.epoch == epoch) {
+                    lua_rawgeti(L, LUA_REGISTRYINDEX, cached.ref);
+                    LOG_DEBUG("Found cached module '{}' for lua_State: {}", module_name, static_cast<void*>(L));
+                    return 1;
+                }
+
+                LOG_DEBUG("Cached module '{}' is stale for lua_State: {}", module_name, static_cast<void*>(L));
+                lua_unref(L, cached.ref);
+                module_cache.erase(cache_it);
             }
 
             std::string resolved_path;
@@ -129,30 +249,59 @@ namespace rml::luau::environment {
                 return original_require(L);
             }
 
-            const std::string source_code = read_file_contents(resolved_path);
-            if (source_code.empty()) {
-                luaL_error(L, "Failed to read module file: %s", resolved_path.c_str());
-                return 0;
-            }
+            record_dependency(L, resolved_path);
 
-            constexpr auto compilation_opts = Luau::CompileOptions{
-                .optimizationLevel = 1,
-                .debugLevel = 2,
-            };
+            // Another state may already have compiled this file; only this state's executed value is missing
+            const auto epoch = require_impl::g_module_store.epoch();
+            const auto write_time = module_write_time(resolved_path);
+            auto module = require_impl::g_module_store.find(resolved_path);
+
+            if (!module || module->write_time != write_time) {
+                const std::string source_code = read_file_contents(resolved_path);
+                if (source_code.empty()) {
+                    luaL_error(L, "Failed to read module file: %s", resolved_path.c_str());
+                    return 0;
+                }
+
+                // Packages may ship the module precompiled with these options
+                BytecodeCache::Bytecode compiled;
+                if (const auto packaged = ModPackage::resolve(resolved_path)) {
+                    if (auto precompiled = packaged->package->read_bytecode(packaged->entry_path,
+                                                                            MOD_COMPILE_OPTIONS)) {
+                        compiled = std::make_shared<const std::string>(std::move(*precompiled));
+                    }
+                }
+                if (!compiled) {
+                    compiled = compile_cached(source_code, MOD_COMPILE_OPTIONS, get_mod_path(L));
+                }
+
+                module = std::make_shared<const require_impl::SharedModule>(require_impl::SharedModule{
+                    .resolved_path = resolved_path,
+                    .bytecode = std::move(compiled),
+                    .write_time = write_time
+                });
+
+                // Compile errors are reported by luau_load below and never shared
+                if (!BytecodeCache::is_compile_error(*module->bytecode)) {
+                    module = require_impl::g_module_store.publish(std::move(module));
+                }
+            }
 
             ScriptContext::set_thread_identity(L, RBX::Security::Permissions::RobloxEngine,
                                                RBX::Security::FULL_CAPABILITIES);
 
-            const auto bytecode = Luau::compile(source_code, compilation_opts);
-            if (bytecode.empty()) {
-                luaL_error(L, "Failed to compile module: %s", resolved_path.c_str());
+            const auto &bytecode = module->bytecode;
+            if (BytecodeCache::is_compile_error(*bytecode)) {
+                const std::string message(BytecodeCache::compile_error_message(*bytecode));
+                luaL_error(L, "Failed to compile module %s: %s", resolved_path.c_str(), message.c_str());
                 return 0;
             }
 
-            const std::string chunk_name = std::format("={}", module_name);
+            // Named by path so modules it requires in turn can be traced back to it
+            const std::string chunk_name = std::format("@{}", resolved_path);
 
-            if (g_pointers->m_roblox_pointers.luau_load(L, chunk_name.c_str(), bytecode.data(), bytecode.size(), 0) !=
-                0) {
+            if (g_pointers->m_roblox_pointers.luau_load(L, chunk_name.c_str(), bytecode->data(), bytecode->size(),
+                                                        0) != 0) {
                 lua_error(L);
                 return 0;
             }
@@ -169,7 +318,11 @@ namespace rml::luau::environment {
 
             lua_pushvalue(L, -1);
             const int ref = lua_ref(L, -1);
-            module_cache[module_name] = ref;
+            module_cache[module_name] = require_impl::CachedModule{
+                .ref = ref,
+                .module = std::move(module),
+                .epoch = epoch
+            };
 
             LOG_DEBUG("Cached module '{}' with ref {} for lua_State: {}", module_name, ref, static_cast<void*>(L));
 
@@ -216,6 +369,31 @@ namespace rml::luau::environment {
         return "";
     }
 
+    void RequireProvider::record_dependency(lua_State *L, const std::string &resolved_path) {
+        lua_Debug ar{};
+        if (!lua_getinfo(L, 1, "s", &ar) || !ar.source || ar.source[0] != '@') {
+            return; // Required from a chunk that isn't a file, e.g. loadstring
+        }
+
+        require_impl::g_module_graph.record(ar.source + 1, resolved_path);
+    }
+
+    std::filesystem::path RequireProvider::get_mod_path(lua_State *L) {
+        std::filesystem::path mod_path;
+
+        lua_getglobal(L, "_RML_MOD_CONTEXT");
+        if (lua_istable(L, -1)) {
+            lua_getfield(L, -1, "path");
+            if (lua_isstring(L, -1)) {
+                mod_path = lua_tostring(L, -1);
+            }
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+
+        return mod_path;
+    }
+
     std::string RequireProvider::resolve_rml_path(const std::string &module_name) {
         try {
             const auto exe_dir = directory_utils::get_executable_directory();
@@ -255,9 +433,10 @@ namespace rml::luau::environment {
 
             const auto mod_dir = std::filesystem::path(mod_path);
 
+            // Goes through file_exists so a mod path that is a .rmlpkg resolves inside the package
             for (const std::vector<std::string> extensions = {".lua", ".luau"}; const auto &ext: extensions) {
                 std::filesystem::path full_path = mod_dir / "scripts" / (module_name + ext);
-                if (std::filesystem::exists(full_path)) {
+                if (file_exists(full_path.string())) {
                     return normalize_path(full_path.string());
                 }
             }
@@ -279,14 +458,41 @@ namespace rml::luau::environment {
 
     bool RequireProvider::file_exists(const std::string &path) {
         try {
-            return std::filesystem::exists(path) && std::filesystem::is_regular_file(path);
+            if (std::filesystem::exists(path) && std::filesystem::is_regular_file(path)) {
+                return true;
+            }
+
+            const auto packaged = ModPackage::resolve(path);
+            return packaged && packaged->package->find(packaged->entry_path);
         } catch (const std::exception &) {
             return false;
         }
     }
 
+    std::filesystem::file_time_type RequireProvider::module_write_time(const std::string &path) {
+        std::error_code ec;
+        if (const auto write_time = std::filesystem::last_write_time(path, ec); !ec) {
+            return write_time;
+        }
+
+        if (const auto packaged = ModPackage::resolve(path)) {
+            return std::filesystem::last_write_time(packaged->package->path(), ec);
+        }
+
+        return {};
+    }
+
     std::string RequireProvider::read_file_contents(const std::string &path) {
         try {
+            if (const auto packaged = ModPackage::resolve(path)) {
+                auto contents = packaged->package->read(packaged->entry_path);
+                if (!contents) {
+                    LOG_ERROR("{}", contents.error());
+                    return "";
+                }
+                return std::move(*contents);
+            }
+
             const std::ifstream file(path, std::ios::binary);
             if (!file.is_open()) {
                 LOG_ERROR("Failed to open file: {}", path);
@@ -1,6 +1,12 @@
 #include "RobloxModLoader/common.hpp"
 #include "RobloxModLoader/luau/environment/rml_provider.hpp"
 
+#include "RobloxModLoader/luau/execution_monitor.hpp"
+#include "RobloxModLoader/luau/sampling_profiler.hpp"
+#include "RobloxModLoader/luau/script_engine.hpp"
+#include "RobloxModLoader/roblox/data_model.hpp"
+#include "RobloxModLoader/roblox/task_scheduler.hpp"
+
 namespace rml::luau::environment {
     namespace rml_logger_impl {
         int info(lua_State *L) {
@@ -213,6 +219,222 @@ namespace rml::luau::environment {
         }
     }
 
+    namespace rml_scheduler_impl {
+        namespace {
+            std::shared_ptr<ScriptEngine> find_engine(lua_State *L) {
+                if (!g_task_scheduler) {
+                    return nullptr;
+                }
+
+                const auto main_thread = lua_mainthread(L);
+
+                for (const auto type: {
+                         RBX::DataModelType::Edit, RBX::DataModelType::Client, RBX::DataModelType::Server,
+                         RBX::DataModelType::Standalone
+                     }) {
+                    const auto engine = g_task_scheduler->get_script_engine(type);
+                    if (engine && lua_mainthread(engine->get_context().get_thread_state()) == main_thread) {
+                        return engine;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            double to_milliseconds(const std::chrono::nanoseconds value) {
+                return std::chrono::duration<double, std::milli>(value).count();
+            }
+
+            void push_percentiles(lua_State *L, const ScriptScheduler::LatencyPercentiles &percentiles) {
+                lua_createtable(L, 0, 5);
+
+                lua_pushnumber(L, static_cast<double>(percentiles.samples));
+                lua_setfield(L, -2, "samples");
+                lua_pushnumber(L, to_milliseconds(percentiles.p50));
+                lua_setfield(L, -2, "p50");
+                lua_pushnumber(L, to_milliseconds(percentiles.p95));
+                lua_setfield(L, -2, "p95");
+                lua_pushnumber(L, to_milliseconds(percentiles.p99));
+                lua_setfield(L, -2, "p99");
+                lua_pushnumber(L, to_milliseconds(percentiles.max));
+                lua_setfield(L, -2, "max");
+            }
+        }
+
+        // rml.scheduler.stats([mod_name]) -> table; latencies are in milliseconds
+        int get_stats(lua_State *L) {
+            const char *mod_filter = luaL_optstring(L, 1, nullptr);
+
+            const auto engine = find_engine(L);
+            if (!engine) {
+                luaL_error(L, "No script engine owns this state");
+            }
+
+            const auto stats = engine->get_scheduler().get_statistics();
+
+            lua_createtable(L, 0, 11);
+
+            lua_pushnumber(L, static_cast<double>(stats.total_executed));
+            lua_setfield(L, -2, "total_executed");
+            lua_pushnumber(L, static_cast<double>(stats.queued_scripts));
+            lua_setfield(L, -2, "queued");
+            lua_pushnumber(L, static_cast<double>(stats.yielded_scripts));
+            lua_setfield(L, -2, "yielded");
+            lua_pushnumber(L, static_cast<double>(stats.delayed_scripts));
+            lua_setfield(L, -2, "delayed");
+            lua_pushnumber(L, to_milliseconds(stats.total_execution_time));
+            lua_setfield(L, -2, "total_time");
+            lua_pushnumber(L, to_milliseconds(stats.average_execution_time));
+            lua_setfield(L, -2, "average_time");
+
+            push_percentiles(L, stats.queue_wait);
+            lua_setfield(L, -2, "queue_wait");
+            push_percentiles(L, stats.run_time);
+            lua_setfield(L, -2, "run_time");
+            push_percentiles(L, stats.resume_time);
+            lua_setfield(L, -2, "resume_time");
+
+            lua_newtable(L);
+            int index = 1;
+            for (const auto &script: stats.script_latency) {
+                if (mod_filter && script.mod_name != mod_filter) {
+                    continue;
+                }
+
+                lua_createtable(L, 0, 5);
+
+                lua_pushstring(L, script.mod_name.c_str());
+                lua_setfield(L, -2, "mod");
+                lua_pushstring(L, script.chunk_name.c_str());
+                lua_setfield(L, -2, "chunk");
+                push_percentiles(L, script.queue_wait);
+                lua_setfield(L, -2, "queue_wait");
+                push_percentiles(L, script.run_time);
+                lua_setfield(L, -2, "run_time");
+                push_percentiles(L, script.resume_time);
+                lua_setfield(L, -2, "resume_time");
+
+                lua_rawseti(L, -2, index++);
+            }
+            lua_setfield(L, -2, "scripts");
+
+            lua_newtable(L);
+            index = 1;
+            for (const auto &resources: stats.mod_resources) {
+                if (mod_filter && resources.mod_name != mod_filter) {
+                    continue;
+                }
+
+                lua_createtable(L, 0, 8);
+
+                lua_pushstring(L, resources.mod_name.c_str());
+                lua_setfield(L, -2, "mod");
+                lua_pushnumber(L, static_cast<double>(resources.live_bytes));
+                lua_setfield(L, -2, "live_bytes");
+                lua_pushnumber(L, static_cast<double>(resources.peak_bytes));
+                lua_setfield(L, -2, "peak_bytes");
+                lua_pushnumber(L, static_cast<double>(resources.memory_limit));
+                lua_setfield(L, -2, "memory_limit");
+                lua_pushnumber(L, static_cast<double>(resources.limit_hits));
+                lua_setfield(L, -2, "limit_hits");
+                lua_pushboolean(L, resources.over_limit);
+                lua_setfield(L, -2, "over_limit");
+                lua_pushnumber(L, static_cast<double>(resources.execution_limit.count()));
+                lua_setfield(L, -2, "execution_limit");
+                lua_pushnumber(L, static_cast<double>(resources.overruns));
+                lua_setfield(L, -2, "overruns");
+
+                lua_rawseti(L, -2, index++);
+            }
+            lua_setfield(L, -2, "resources");
+
+            return 1;
+        }
+
+        // rml.scheduler.verify_preemption() -> boolean; spins for up to 100 ms, so only for diagnosing a client
+        // where scripts that never yield aren't stopped
+        int verify_preemption(lua_State *L) {
+            lua_pushboolean(L, ExecutionMonitor::verify_preemption(L));
+            return 1;
+        }
+    }
+
+    namespace rml_profiler_impl {
+        namespace {
+            SamplingProfiler::ExportFormat check_format(lua_State *L, const int index) {
+                const auto format = SamplingProfiler::parse_format(luaL_optstring(L, index, "collapsed"));
+                if (!format) {
+                    luaL_error(L, "Unknown profile format (expected 'collapsed' or 'chrome')");
+                }
+                return *format;
+            }
+        }
+
+        // rml.profiler.start([interval_ms]); fractional intervals are allowed
+        int start(lua_State *L) {
+            const auto interval_ms = luaL_optnumber(L, 1, 1.0);
+            const auto interval = std::chrono::microseconds(static_cast<std::int64_t>(interval_ms * 1000.0));
+
+            if (const auto started = SamplingProfiler::instance().start(interval); !started) {
+                luaL_error(L, "%s", started.error().c_str());
+            }
+            return 0;
+        }
+
+        int stop(lua_State *L) {
+            SamplingProfiler::instance().stop();
+            return 0;
+        }
+
+        int reset(lua_State *L) {
+            SamplingProfiler::instance().reset();
+            return 0;
+        }
+
+        int is_running(lua_State *L) {
+            lua_pushboolean(L, SamplingProfiler::instance().is_running());
+            return 1;
+        }
+
+        int get_stats(lua_State *L) {
+            const auto stats = SamplingProfiler::instance().get_statistics();
+
+            lua_createtable(L, 0, 5);
+            lua_pushboolean(L, stats.running);
+            lua_setfield(L, -2, "running");
+            lua_pushnumber(L, std::chrono::duration<double, std::milli>(stats.interval).count());
+            lua_setfield(L, -2, "interval");
+            lua_pushnumber(L, static_cast<double>(stats.samples));
+            lua_setfield(L, -2, "samples");
+            lua_pushnumber(L, static_cast<double>(stats.dropped_samples));
+            lua_setfield(L, -2, "dropped");
+            lua_pushnumber(L, static_cast<double>(stats.unique_stacks));
+            lua_setfield(L, -2, "stacks");
+            return 1;
+        }
+
+        // rml.profiler.dump([format]) -> string
+        int dump(lua_State *L) {
+            const auto format = check_format(L, 1);
+            const auto data = SamplingProfiler::instance().export_as(format);
+            lua_pushlstring(L, data.data(), data.size());
+            return 1;
+        }
+
+        // rml.profiler.save([format]) -> path; always written to the loader's profiles directory
+        int save(lua_State *L) {
+            const auto format = check_format(L, 1);
+            const auto path = SamplingProfiler::instance().save(format);
+            if (!path) {
+                luaL_error(L, "%s", path.error().c_str());
+            }
+
+            const auto path_string = path->string();
+            lua_pushlstring(L, path_string.data(), path_string.size());
+            return 1;
+        }
+    }
+
     bool RMLProvider::register_globals(lua_State *L) noexcept {
         try {
             register_core_namespace(L);
@@ -236,6 +458,10 @@ namespace rml::luau::environment {
 
         register_utilities_table(L);
 
+        register_scheduler_table(L);
+
+        register_profiler_table(L);
+
         lua_setglobal(L, NAME.data());
     }
 
@@ -290,6 +516,37 @@ namespace rml::luau::environment {
         lua_setfield(L, -2, "utils");
     }
 
+    void RMLProvider::register_scheduler_table(lua_State *L) noexcept {
+        lua_newtable(L);
+
+        constexpr luaL_Reg scheduler_funcs[] = {
+            {"stats", rml_scheduler_impl::get_stats},
+            {"verify_preemption", rml_scheduler_impl::verify_preemption},
+            {nullptr, nullptr}
+        };
+
+        luaL_register(L, nullptr, scheduler_funcs);
+        lua_setfield(L, -2, "scheduler");
+    }
+
+    void RMLProvider::register_profiler_table(lua_State *L) noexcept {
+        lua_newtable(L);
+
+        constexpr luaL_Reg profiler_funcs[] = {
+            {"start", rml_profiler_impl::start},
+            {"stop", rml_profiler_impl::stop},
+            {"reset", rml_profiler_impl::reset},
+            {"running", rml_profiler_impl::is_running},
+            {"stats", rml_profiler_impl::get_stats},
+            {"dump", rml_profiler_impl::dump},
+            {"save", rml_profiler_impl::save},
+            {nullptr, nullptr}
+        };
+
+        luaL_register(L, nullptr, profiler_funcs);
+        lua_setfield(L, -2, "profiler");
+    }
+
     void RMLProvider::set_mod_context(lua_State *L, const ModContext &context) noexcept {
         try {
             lua_newtable(L);
@@ -318,32 +575,51 @@ namespace rml::luau::environment {
 
             lua_setglobal(L, "_RML_MOD_CONTEXT");
 
-            lua_getglobal(L, "rml");
-            if (lua_istable(L, -1)) {
-                lua_getfield(L, -1, "mod");
-                if (lua_istable(L, -1)) {
-                    lua_pushstring(L, context.mod_name.c_str());
-                    lua_setfield(L, -2, "name");
-                    lua_pushstring(L, context.mod_version.c_str());
-                    lua_setfield(L, -2, "version");
-                    lua_pushstring(L, context.mod_description.c_str());
-                    lua_setfield(L, -2, "description");
-                    lua_pushstring(L, context.mod_author.c_str());
-                    lua_setfield(L, -2, "author");
-
-                    lua_pushstring(L, context.mod_path.string().c_str());
-                    lua_setfield(L, -2, "path");
-
-                    // TODO: Future support for dependencies
-                    // lua_newtable(L);
-                    // for (size_t i = 0; i < context.mod_dependencies.size(); ++i) {
-                    //     lua_pushstring(L, context.mod_dependencies[i].c_str());
-                    //     lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
-                    // }
-                    // lua_setfield(L, -2, "dependencies");
-                }
+            // The rml table in the environment template is read-only and shared by every mod, so the
+            // environment gets its own rml that falls back to it and holds this mod's table
+            lua_rawgetfield(L, LUA_GLOBALSINDEX, NAME.data());
+            if (!lua_istable(L, -1)) {
                 lua_pop(L, 1);
+                lua_getglobal(L, NAME.data());
+                if (!lua_istable(L, -1)) {
+                    lua_pop(L, 1);
+                    return;
+                }
+
+                lua_newtable(L);
+                lua_newtable(L);
+                lua_pushvalue(L, -3);
+                lua_setfield(L, -2, "__index");
+                lua_setreadonly(L, -1, true);
+                lua_setmetatable(L, -2);
+                lua_remove(L, -2);
+
+                lua_pushvalue(L, -1);
+                lua_setglobal(L, NAME.data());
             }
+
+            lua_newtable(L);
+            lua_pushstring(L, context.mod_name.c_str());
+            lua_setfield(L, -2, "name");
+            lua_pushstring(L, context.mod_version.c_str());
+            lua_setfield(L, -2, "version");
+            lua_pushstring(L, context.mod_description.c_str());
+            lua_setfield(L, -2, "description");
+            lua_pushstring(L, context.mod_author.c_str());
+            lua_setfield(L, -2, "author");
+
+            lua_pushstring(L, context.mod_path.string().c_str());
+            lua_setfield(L, -2, "path");
+
+            // TODO: Future support for dependencies
+            // lua_newtable(L);
+            // for (size_t i = 0; i < context.mod_dependencies.size(); ++i) {
+            //     lua_pushstring(L, context.mod_dependencies[i].c_str());
+            //     lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+            // }
+            // lua_setfield(L, -2, "dependencies");
+
+            lua_setfield(L, -2, "mod");
             lua_pop(L, 1);
         } catch (const std::exception &e) {
             LOG_ERROR("Failed to set mod context: {}", e.what());
@@ -0,0 +1,137 @@
+#include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/luau/environment/shared_data_store.hpp"
+
+namespace rml::luau::environment {
+    SharedDataStore::SharedDataStore()
+        : m_shards(std::make_unique<Shard[]>(SHARD_COUNT))
+          , m_nil(std::make_shared<const LuaValue>(nullptr))
+          , m_subscriptions(std::make_shared<const SubscriptionMap>()) {
+    }
+
+    SharedDataStore::Shard &SharedDataStore::shard_for(const std::string_view key) const noexcept {
+        return m_shards[NameHash{}(key) & (SHARD_COUNT - 1)];
+    }
+
+    std::uint64_t SharedDataStore::set(const std::string_view key, LuaValue value) {
+        // Built outside the lock; readers holding the old value keep it alive
+        auto shared_value = std::make_shared<const LuaValue>(std::move(value));
+
+        std::uint64_t version;
+        {
+            auto &shard = shard_for(key);
+            std::unique_lock lock(shard.mutex);
+
+            auto it = shard.entries.find(key);
+            if (it == shard.entries.end()) {
+                it = shard.entries.emplace(std::string(key), Entry{}).first;
+            }
+
+            it->second.value = std::move(shared_value);
+            version = ++it->second.version;
+        }
+
+        {
+            std::lock_guard lock(m_dirty_mutex);
+            if (!m_dirty.contains(key)) {
+                m_dirty.emplace(key);
+            }
+            m_has_changes.store(true, std::memory_order_release);
+        }
+
+        return version;
+    }
+
+    SharedDataSnapshot SharedDataStore::get(const std::string_view key) const {
+        const auto &shard = shard_for(key);
+        std::shared_lock lock(shard.mutex);
+
+        if (const auto it = shard.entries.find(key); it != shard.entries.end()) {
+            return SharedDataSnapshot{.value = it->second.value, .version = it->second.version};
+        }
+
+        return SharedDataSnapshot{.value = m_nil, .version = 0};
+    }
+
+    std::uint64_t SharedDataStore::version(const std::string_view key) const {
+        const auto &shard = shard_for(key);
+        std::shared_lock lock(shard.mutex);
+
+        const auto it = shard.entries.find(key);
+        return it != shard.entries.end() ? it->second.version : 0;
+    }
+
+    std::size_t SharedDataStore::subscribe(const std::string_view key, SharedDataCallback callback) {
+        std::lock_guard lock(m_subscriptions_mutex);
+        const auto id = m_next_subscription_id.fetch_add(1, std::memory_order_relaxed);
+
+        auto map = std::make_shared<SubscriptionMap>(*m_subscriptions.load(std::memory_order_acquire));
+        auto it = map->find(key);
+        if (it == map->end()) {
+            it = map->emplace(std::string(key), std::vector<Subscription>{}).first;
+        }
+        it->second.push_back(Subscription{.id = id, .callback = std::move(callback)});
+
+        m_subscriptions.store(std::move(map), std::memory_order_release);
+        return id;
+    }
+
+    void SharedDataStore::unsubscribe(const std::size_t id) {
+        std::lock_guard lock(m_subscriptions_mutex);
+        auto map = std::make_shared<SubscriptionMap>(*m_subscriptions.load(std::memory_order_acquire));
+
+        for (auto it = map->begin(); it != map->end(); ++it) {
+            if (std::erase_if(it->second, [id](const Subscription &s) { return s.id == id; }) > 0) {
+                if (it->second.empty()) {
+                    map->erase(it);
+                }
+                m_subscriptions.store(std::move(map), std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    std::size_t SharedDataStore::dispatch_changes() noexcept {
+        if (!m_has_changes.exchange(false, std::memory_order_acq_rel)) {
+            return 0;
+        }
+
+        decltype(m_dirty) dirty;
+        {
+            std::lock_guard lock(m_dirty_mutex);
+            dirty.swap(m_dirty);
+        }
+
+        const auto subscriptions = m_subscriptions.load(std::memory_order_acquire);
+        if (subscriptions->empty()) {
+            return dirty.size();
+        }
+
+        const auto all_keys = subscriptions->find(std::string_view{});
+
+        for (const auto &key: dirty) {
+            const auto keyed = subscriptions->find(key);
+            if (keyed == subscriptions->end() && all_keys == subscriptions->end()) {
+                continue;
+            }
+
+            // Writes made since the swap are delivered again next dispatch
+            const auto snapshot = get(key);
+
+            for (const auto it: {keyed, all_keys}) {
+                if (it == subscriptions->end()) {
+                    continue;
+                }
+
+                for (const auto &[id, callback]: it->second) {
+                    try {
+                        callback(key, snapshot);
+                    } catch (const std::exception &e) {
+                        LOG_ERROR("Shared data subscriber for '{}' failed: {}", key, e.what());
+                    }
+                }
+            }
+        }
+
+        return dirty.size();
+    }
+}
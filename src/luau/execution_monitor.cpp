@@ -0,0 +1,293 @@
+#include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/luau/execution_monitor.hpp"
+
+#include "RobloxModLoader/luau/sampling_profiler.hpp"
+#include "pointers.hpp"
+
+#include "lstate.h"
+
+namespace rml::luau {
+    namespace {
+        // One per DataModel, so a handful at most
+        constexpr std::size_t MAX_GLOBAL_STATES = 8;
+
+        // Spins for 20 times the deadline it runs under, so finishing means nothing stopped it. Bounded by the
+        // clock rather than an iteration count, so a client that doesn't preempt is only held up for 100 ms.
+        constexpr std::string_view PREEMPTION_CHECK_SOURCE =
+            "local start = os.clock() local n = 0 while os.clock() - start < 0.1 do n += 1 end return n";
+        constexpr std::chrono::milliseconds PREEMPTION_CHECK_LIMIT{5};
+
+        struct ChainedInterrupt {
+            std::atomic<lua_State *> main_thread{nullptr};
+            std::atomic<ExecutionMonitor::InterruptCallback> previous{nullptr};
+            // By memory category, so code running outside a scope is still charged to its mod
+            std::array<std::atomic<ModResourceAccount *>, LUA_MEMORY_CATEGORIES> accounts{};
+        };
+
+        std::array<ChainedInterrupt, MAX_GLOBAL_STATES> g_chained_interrupts;
+        std::mutex g_install_mutex;
+        std::atomic<std::uint32_t> g_install_generation{1};
+
+        // The last lookup, since a thread almost always keeps running on the same state
+        struct SlotCache {
+            lua_State *main_thread{nullptr};
+            ChainedInterrupt *slot{nullptr};
+            std::uint32_t generation{0};
+        };
+
+        thread_local SlotCache t_slot_cache;
+        thread_local ExecutionMonitor::Scope *t_current_scope{nullptr};
+        thread_local std::uint32_t t_limit_check_counter{0};
+
+        // Slot of L's state; nullptr if the monitor isn't installed on it
+        ChainedInterrupt *slot_of(lua_State *L) noexcept {
+            const auto main_thread = lua_mainthread(L);
+            const auto generation = g_install_generation.load(std::memory_order_acquire);
+
+            if (t_slot_cache.main_thread == main_thread && t_slot_cache.generation == generation) {
+                return t_slot_cache.slot;
+            }
+
+            ChainedInterrupt *slot = nullptr;
+            for (auto &chained: g_chained_interrupts) {
+                if (chained.main_thread.load(std::memory_order_acquire) == main_thread) {
+                    slot = &chained;
+                    break;
+                }
+            }
+
+            t_slot_cache = {main_thread, slot, generation};
+            return slot;
+        }
+
+        // Account of the mod whose memory category L allocates in, or nullptr for code that isn't a mod's
+        ModResourceAccount *account_of(lua_State *L) noexcept {
+            const auto slot = slot_of(L);
+            return slot ? slot->accounts[L->activememcat].load(std::memory_order_acquire) : nullptr;
+        }
+    }
+
+    ExecutionMonitor::Scope::Scope(const std::string_view mod_name, ModResourceAccount *account,
+                                   const std::chrono::milliseconds time_limit) noexcept
+        : m_mod_name(mod_name)
+          , m_account(account)
+          , m_time_limit(time_limit)
+          , m_deadline(time_limit.count() > 0
+                           ? std::chrono::steady_clock::now() + time_limit
+                           : std::chrono::steady_clock::time_point::max())
+          , m_previous(t_current_scope) {
+        t_current_scope = this;
+    }
+
+    ExecutionMonitor::Scope::~Scope() noexcept {
+        t_current_scope = m_previous;
+    }
+
+    void ExecutionMonitor::install(lua_State *L) noexcept {
+        if (!L) {
+            return;
+        }
+
+        auto *callbacks = lua_callbacks(L);
+        if (callbacks->interrupt == &interrupt) {
+            return;
+        }
+
+        std::lock_guard lock(g_install_mutex);
+        const auto main_thread = lua_mainthread(L);
+
+        // A slot left by a destroyed state whose main thread address got reused is taken over
+        ChainedInterrupt *slot = nullptr;
+        for (auto &chained: g_chained_interrupts) {
+            if (chained.main_thread.load(std::memory_order_relaxed) == main_thread) {
+                slot = &chained;
+                break;
+            }
+            if (!slot && !chained.main_thread.load(std::memory_order_relaxed)) {
+                slot = &chained;
+            }
+        }
+
+        if (!slot) {
+            LOG_WARN("Interrupt callbacks are already installed on {} states; skipping lua_State: {}",
+                     MAX_GLOBAL_STATES, static_cast<void *>(L));
+            return;
+        }
+
+        // Accounts left by a destroyed state are gone with its scheduler
+        for (auto &account: slot->accounts) {
+            account.store(nullptr, std::memory_order_relaxed);
+        }
+        slot->previous.store(callbacks->interrupt, std::memory_order_relaxed);
+        slot->main_thread.store(main_thread, std::memory_order_release);
+        g_install_generation.fetch_add(1, std::memory_order_release);
+
+        callbacks->interrupt = &interrupt;
+
+        LOG_DEBUG("Installed interrupt callback for lua_State: {}", static_cast<void *>(L));
+    }
+
+    void ExecutionMonitor::register_account(lua_State *L, ModResourceAccount &account) noexcept {
+        if (!L || account.category == 0) {
+            return;
+        }
+
+        std::lock_guard lock(g_install_mutex);
+        if (const auto slot = slot_of(L)) {
+            slot->accounts[account.category].store(&account, std::memory_order_release);
+        }
+    }
+
+    bool ExecutionMonitor::verify_preemption(lua_State *L) noexcept {
+        try {
+            const auto bytecode = Luau::compile(std::string(PREEMPTION_CHECK_SOURCE));
+
+            lua_State *thread = lua_newthread(L);
+            const auto start = std::chrono::steady_clock::now();
+            const int status = [thread, &bytecode] {
+                const int load_status = g_pointers->m_roblox_pointers.luau_load(
+                    thread, "=rml_preemption_check", bytecode.data(), bytecode.size(), 0);
+                if (load_status != LUA_OK) {
+                    return load_status;
+                }
+
+                const Scope scope("<preemption check>", nullptr, PREEMPTION_CHECK_LIMIT);
+                return lua_resume(thread, nullptr, 0);
+            }();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+            const std::string message = lua_isstring(thread, -1) ? lua_tostring(thread, -1) : "";
+            lua_pop(L, 1);
+
+            if (status == LUA_OK) {
+                LOG_ERROR("A script that never yields ran for {} ms past a {} ms limit; execution time limits are "
+                          "not enforced on lua_State: {}", elapsed.count(), PREEMPTION_CHECK_LIMIT.count(),
+                          static_cast<void *>(L));
+                return false;
+            }
+
+            if (message.find("execution time limit") == std::string::npos) {
+                LOG_WARN("Could not check script preemption: {}", message);
+                return false;
+            }
+
+            LOG_DEBUG("Verified script preemption after {} ms", elapsed.count());
+            return true;
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to check script preemption: {}", e.what());
+            return false;
+        }
+    }
+
+    const ExecutionMonitor::Scope *ExecutionMonitor::current() noexcept {
+        return t_current_scope;
+    }
+
+    ExecutionMonitor::InterruptCallback ExecutionMonitor::previous_interrupt(lua_State *L) noexcept {
+        const auto slot = slot_of(L);
+        return slot ? slot->previous.load(std::memory_order_relaxed) : nullptr;
+    }
+
+    bool ExecutionMonitor::refresh_memory(lua_State *L, ModResourceAccount &account) noexcept {
+        if (account.category == 0) {
+            return true;
+        }
+
+        const auto live = lua_totalbytes(L, account.category);
+        account.live_bytes.store(live, std::memory_order_relaxed);
+
+        auto peak = account.peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !account.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+
+        const auto limit = account.memory_limit.load(std::memory_order_relaxed);
+        if (limit == 0 || live <= limit) {
+            account.over_limit.store(false, std::memory_order_relaxed);
+            // Only well under the limit again, so a mod hovering at it doesn't force a full collection each check
+            if (live <= limit - limit / 4) {
+                account.collected.store(false, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    void ExecutionMonitor::enforce_memory_limit(lua_State *L, ModResourceAccount &account) {
+        if (refresh_memory(L, account)) {
+            return;
+        }
+
+        // Part of it may be garbage not yet swept, which isn't the mod's fault
+        if (!account.collected.exchange(true, std::memory_order_relaxed)) {
+            lua_gc(L, LUA_GCCOLLECT, 0);
+            if (refresh_memory(L, account)) {
+                return;
+            }
+        }
+
+        account.limit_hits.fetch_add(1, std::memory_order_relaxed);
+        if (!account.over_limit.exchange(true, std::memory_order_relaxed)) {
+            LOG_WARN("Mod '{}' exceeded its memory limit ({} of {} bytes)", account.mod_name,
+                     account.live_bytes.load(std::memory_order_relaxed),
+                     account.memory_limit.load(std::memory_order_relaxed));
+        }
+
+        luaL_error(L, "Mod '%s' exceeded its memory limit (%zu of %zu bytes)", account.mod_name.c_str(),
+                   account.live_bytes.load(std::memory_order_relaxed),
+                   account.memory_limit.load(std::memory_order_relaxed));
+    }
+
+    void ExecutionMonitor::enforce_deadline(lua_State *L, Scope &scope) {
+        if (std::chrono::steady_clock::now() < scope.m_deadline) {
+            return;
+        }
+
+        // A script that catches the error keeps hitting it on every later check until the run ends
+        if (!scope.m_overran) {
+            scope.m_overran = true;
+            if (scope.m_account) {
+                scope.m_account->overruns.fetch_add(1, std::memory_order_relaxed);
+            }
+            LOG_WARN("Preempted a script of mod '{}' after {} ms", scope.m_mod_name, scope.m_time_limit.count());
+        }
+
+        luaL_error(L, "Mod '%.*s' script exceeded its execution time limit of %lld ms",
+                   static_cast<int>(scope.m_mod_name.size()), scope.m_mod_name.data(),
+                   static_cast<long long>(scope.m_time_limit.count()));
+    }
+
+    void ExecutionMonitor::interrupt(lua_State *L, const int gc) {
+        // gc is -1 unless the interrupt comes from a GC step, where raising an error isn't allowed
+        if (gc < 0) {
+            // Outside a scope (bridge callbacks, code resumed by Roblox), the memory category still names the mod
+            if (SamplingProfiler::sample_due()) {
+                std::string_view mod_name;
+                if (t_current_scope) {
+                    mod_name = t_current_scope->mod_name();
+                } else if (const auto account = account_of(L)) {
+                    mod_name = account->mod_name;
+                }
+                SamplingProfiler::instance().sample(L, mod_name);
+            }
+
+            if ((++t_limit_check_counter & (LIMIT_CHECK_INTERVAL - 1)) == 0) {
+                if (t_current_scope && t_current_scope->m_time_limit.count() > 0) {
+                    enforce_deadline(L, *t_current_scope);
+                }
+
+                const auto account = t_current_scope && t_current_scope->m_account
+                                         ? t_current_scope->m_account
+                                         : account_of(L);
+                if (account) {
+                    enforce_memory_limit(L, *account);
+                }
+            }
+        }
+
+        if (const auto previous = previous_interrupt(L)) {
+            previous(L, gc);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include "RobloxModLoader/luau/file_watcher.hpp"
+#include "RobloxModLoader/luau/mod_package_format.hpp"
+
+namespace rml::luau {
+    namespace {
+        // How often a notification wait wakes up to check for shutdown
+        constexpr DWORD NOTIFICATION_WAIT_MS = 500;
+    }
+
+    FileWatcher::FileWatcher(std::vector<std::filesystem::path> roots, Callback callback, const Options options)
+        : m_roots(std::move(roots))
+          , m_callback(std::move(callback))
+          , m_options(options)
+          , m_thread([this](const std::stop_token &stop_token) { run(stop_token); }) {
+    }
+
+    FileWatcher::~FileWatcher() {
+        m_thread.request_stop();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    bool FileWatcher::is_watched_file(const std::filesystem::path &path) {
+        // Extensions compare like Windows paths do, ignoring case
+        const auto extension = path.extension().string();
+        return package_format::compare_paths(extension, ".lua") == 0 ||
+               package_format::compare_paths(extension, ".luau") == 0 ||
+               package_format::compare_paths(extension, package_format::EXTENSION) == 0 || path.filename() == "mod.toml";
+    }
+
+    FileWatcher::Snapshot FileWatcher::scan() const {
+        Snapshot snapshot;
+
+        for (const auto &root: m_roots) {
+            std::error_code ec;
+            auto it = std::filesystem::recursive_directory_iterator(
+                root, std::filesystem::directory_options::skip_permission_denied, ec);
+
+            for (const auto end = std::filesystem::recursive_directory_iterator(); !ec && it != end;
+                 it.increment(ec)) {
+                const auto &entry = *it;
+
+                // Skip .rml_cache and other hidden directories
+                if (entry.path().filename().string().starts_with('.')) {
+                    if (entry.is_directory(ec)) {
+                        it.disable_recursion_pending();
+                    }
+                    continue;
+                }
+
+                if (!entry.is_regular_file(ec) || !is_watched_file(entry.path())) {
+                    continue;
+                }
+
+                FileState state;
+                state.write_time = entry.last_write_time(ec);
+                state.size = entry.file_size(ec);
+                if (!ec) {
+                    snapshot.emplace(entry.path(), state);
+                }
+            }
+        }
+
+        return snapshot;
+    }
+
+    void FileWatcher::diff(const Snapshot &before, const Snapshot &after,
+                           std::unordered_map<std::filesystem::path, ChangeKind> &pending) {
+        for (const auto &[path, state]: after) {
+            const auto it = before.find(path);
+            if (it == before.end()) {
+                pending[path] = ChangeKind::Added;
+            } else if (it->second != state) {
+                // A file added earlier in the same batch is still reported as added
+                pending.try_emplace(path, ChangeKind::Modified);
+            }
+        }
+
+        for (const auto &path: before | std::views::keys) {
+            if (!after.contains(path)) {
+                if (const auto it = pending.find(path); it != pending.end() && it->second == ChangeKind::Added) {
+                    pending.erase(it); // Created and deleted within one batch
+                } else {
+                    pending[path] = ChangeKind::Removed;
+                }
+            }
+        }
+    }
+
+    void FileWatcher::run(const std::stop_token &stop_token) {
+        std::vector<HANDLE> notifications;
+        for (const auto &root: m_roots) {
+            const auto handle = FindFirstChangeNotificationW(
+                root.c_str(), TRUE,
+                FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                FILE_NOTIFY_CHANGE_SIZE);
+
+            if (handle == INVALID_HANDLE_VALUE) {
+                LOG_WARN("File change notifications unavailable for '{}', falling back to polling every {}ms",
+                         root.string(), m_options.poll_interval.count());
+                for (const auto notification: notifications) {
+                    FindCloseChangeNotification(notification);
+                }
+                notifications.clear();
+                break;
+            }
+            notifications.push_back(handle);
+        }
+
+        const bool native = !notifications.empty();
+
+        auto snapshot = scan();
+        std::unordered_map<std::filesystem::path, ChangeKind> pending;
+        auto last_change = std::chrono::steady_clock::now();
+
+        while (!stop_token.stop_requested()) {
+            bool rescan = !native;
+
+            if (native) {
+                const auto timeout = pending.empty()
+                                         ? NOTIFICATION_WAIT_MS
+                                         : static_cast<DWORD>(m_options.debounce.count());
+                const auto result = WaitForMultipleObjects(static_cast<DWORD>(notifications.size()),
+                                                           notifications.data(), FALSE, timeout);
+
+                if (result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + notifications.size()) {
+                    FindNextChangeNotification(notifications[result - WAIT_OBJECT_0]);
+                    rescan = true;
+                } else if (result != WAIT_TIMEOUT) {
+                    LOG_ERROR("Waiting for file change notifications failed (error {})", GetLastError());
+                    std::this_thread::sleep_for(m_options.poll_interval);
+                    rescan = true;
+                }
+            } else {
+                std::this_thread::sleep_for(pending.empty() ? m_options.poll_interval : m_options.debounce);
+            }
+
+            if (rescan) {
+                // Writes that don't touch a watched file (e.g. the bytecode cache) leave the snapshot unchanged
+                if (auto current = scan(); current != snapshot) {
+                    diff(snapshot, current, pending);
+                    snapshot = std::move(current);
+                    last_change = std::chrono::steady_clock::now();
+                }
+            }
+
+            if (pending.empty() || std::chrono::steady_clock::now() - last_change < m_options.debounce) {
+                continue;
+            }
+
+            std::vector<Change> changes;
+            changes.reserve(pending.size());
+            for (auto &[path, kind]: pending) {
+                changes.push_back(Change{.path = path, .kind = kind});
+            }
+            pending.clear();
+
+            try {
+                m_callback(changes);
+            } catch (const std::exception &e) {
+                LOG_ERROR("File change handler failed: {}", e.what());
+            }
+        }
+
+        for (const auto notification: notifications) {
+            FindCloseChangeNotification(notification);
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include "RobloxModLoader/luau/lua_thread_pool.hpp"
+#include "RobloxModLoader/luau/environment/require_provider.hpp"
+
+namespace rml::luau {
+    LuaThreadPool::LuaThreadPool(lua_State *parent, const std::size_t max_idle) noexcept
+        : m_parent(parent)
+          , m_max_idle(max_idle) {
+    }
+
+    lua_State *LuaThreadPool::acquire() noexcept {
+        std::lock_guard lock(m_mutex);
+        ++m_statistics.acquired;
+
+        if (m_idle.empty()) {
+            reclaim_locked();
+        }
+
+        if (!m_idle.empty()) {
+            auto pooled = m_idle.back();
+            m_idle.pop_back();
+            pooled.entry = nullptr;
+            m_leased.push_back(pooled);
+            ++m_statistics.reused;
+            return pooled.thread;
+        }
+
+        try {
+            // Anchored by a registry ref instead of being left on the parent's stack
+            const auto thread = lua_newthread(m_parent);
+            if (!thread) {
+                return nullptr;
+            }
+
+            const int ref = lua_ref(m_parent, -1);
+            lua_pop(m_parent, 1);
+
+            m_leased.push_back(PooledThread{.thread = thread, .ref = ref});
+            ++m_statistics.created;
+            return thread;
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to create pooled Lua thread: {}", e.what());
+            return nullptr;
+        }
+    }
+
+    void LuaThreadPool::reclaim() noexcept {
+        std::lock_guard lock(m_mutex);
+        reclaim_locked();
+    }
+
+    LuaThreadPool::Statistics LuaThreadPool::get_statistics() const noexcept {
+        std::lock_guard lock(m_mutex);
+
+        auto statistics = m_statistics;
+        statistics.idle = m_idle.size();
+        statistics.leased = m_leased.size();
+        return statistics;
+    }
+
+    bool LuaThreadPool::is_finished(const PooledThread &pooled) const noexcept {
+        const auto status = lua_costatus(m_parent, pooled.thread);
+        if (status == LUA_COFIN || status == LUA_COERR) {
+            return true;
+        }
+
+        // Running and yielded threads are left alone. The rest are back at their base frame with something on
+        // the stack: either the chunk waiting for its first resume, or the results of a run that was finished by
+        // Roblox's scheduler, which never clears them.
+        if (status != LUA_COSUS || lua_status(pooled.thread) == LUA_YIELD || !pooled.entry) {
+            return false;
+        }
+
+        return lua_gettop(pooled.thread) != 1 || lua_topointer(pooled.thread, 1) != pooled.entry;
+    }
+
+    void LuaThreadPool::reclaim_locked() noexcept {
+        std::erase_if(m_leased, [this](const PooledThread &pooled) {
+            if (!is_finished(pooled)) {
+                return false;
+            }
+
+            if (lua_status(pooled.thread) == LUA_OK && lua_gettop(pooled.thread) > 0) {
+                ++m_statistics.finished_with_results;
+            }
+
+            recycle_locked(pooled);
+            return true;
+        });
+    }
+
+    void LuaThreadPool::mark_loaded(lua_State *thread) noexcept {
+        std::lock_guard lock(m_mutex);
+
+        const auto it = std::ranges::find(m_leased, thread, &PooledThread::thread);
+        if (it != m_leased.end()) {
+            it->entry = lua_topointer(thread, -1);
+        }
+    }
+
+    void LuaThreadPool::release(lua_State *thread) noexcept {
+        std::lock_guard lock(m_mutex);
+
+        const auto it = std::ranges::find(m_leased, thread, &PooledThread::thread);
+        if (it == m_leased.end()) {
+            return;
+        }
+
+        const auto pooled = *it;
+        m_leased.erase(it);
+        recycle_locked(pooled);
+    }
+
+    void LuaThreadPool::clear() noexcept {
+        std::lock_guard lock(m_mutex);
+
+        for (const auto &pooled: m_idle) {
+            unref_locked(pooled);
+        }
+        for (const auto &pooled: m_leased) {
+            unref_locked(pooled);
+        }
+        m_idle.clear();
+        m_leased.clear();
+    }
+
+    void LuaThreadPool::recycle_locked(const PooledThread &pooled) noexcept {
+        if (m_idle.size() < m_max_idle) {
+            // The next script on it starts with its own require cache, as on a new thread
+            environment::require_impl::cleanup_cache_for_state(pooled.thread);
+
+            // Clears the stack and call frames; globals and thread data (identity) are kept
+            lua_resetthread(pooled.thread);
+            m_idle.push_back(pooled);
+            ++m_statistics.recycled;
+        } else {
+            unref_locked(pooled);
+            ++m_statistics.discarded;
+        }
+    }
+
+    void LuaThreadPool::unref_locked(const PooledThread &pooled) const noexcept {
+        environment::require_impl::cleanup_cache_for_state(pooled.thread);
+        lua_unref(m_parent, pooled.ref);
+    }
+}
@@ -0,0 +1,151 @@
+#include "RobloxModLoader/luau/mod_graph.hpp"
+
+#include <algorithm>
+#include <format>
+#include <string_view>
+#include <unordered_map>
+
+namespace rml::luau {
+    ModGraph::Plan ModGraph::solve(const std::vector<Node> &nodes, const std::unordered_set<std::string> &satisfied) {
+        Plan plan;
+        plan.dependencies.resize(nodes.size());
+        plan.wave_of.assign(nodes.size(), REJECTED);
+
+        // Directory names win over display names when both match different mods
+        std::unordered_map<std::string_view, std::size_t> index_by_key;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            index_by_key.try_emplace(nodes[i].id, i);
+        }
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            index_by_key.try_emplace(nodes[i].name, i);
+        }
+
+        std::vector<std::vector<std::size_t> > dependents(nodes.size());
+        std::vector<std::size_t> remaining(nodes.size(), 0);
+        std::vector<bool> failed(nodes.size(), false);
+
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            auto &resolved = plan.dependencies[i];
+
+            for (const auto &dependency: nodes[i].dependencies) {
+                if (dependency.empty()) {
+                    continue;
+                }
+
+                if (const auto it = index_by_key.find(dependency); it != index_by_key.end()) {
+                    if (std::ranges::find(resolved, it->second) == resolved.end()) {
+                        resolved.push_back(it->second);
+                        dependents[it->second].push_back(i);
+                    }
+                    continue;
+                }
+
+                if (satisfied.contains(dependency)) {
+                    continue;
+                }
+
+                if (!failed[i]) {
+                    failed[i] = true;
+                    plan.errors.push_back(std::format("Mod '{}' depends on missing mod '{}'",
+                                                      nodes[i].name, dependency));
+                }
+            }
+
+            remaining[i] = resolved.size();
+        }
+
+        // Kahn's algorithm, one layer at a time: a layer holds every mod whose dependencies all sit in
+        // earlier layers
+        std::vector<std::size_t> current;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (remaining[i] == 0) {
+                current.push_back(i);
+            }
+        }
+
+        while (!current.empty()) {
+            std::vector<std::size_t> wave;
+            std::vector<std::size_t> next;
+
+            for (const auto node: current) {
+                if (!failed[node]) {
+                    if (const auto failed_dependency = std::ranges::find_if(
+                        plan.dependencies[node], [&failed](const std::size_t dependency) {
+                            return failed[dependency];
+                        }); failed_dependency != plan.dependencies[node].end()) {
+                        failed[node] = true;
+                        plan.errors.push_back(std::format("Mod '{}' skipped: dependency '{}' failed to load",
+                                                          nodes[node].name, nodes[*failed_dependency].name));
+                    }
+                }
+
+                if (!failed[node]) {
+                    plan.wave_of[node] = plan.waves.size();
+                    wave.push_back(node);
+                }
+
+                for (const auto dependent: dependents[node]) {
+                    if (--remaining[dependent] == 0) {
+                        next.push_back(dependent);
+                    }
+                }
+            }
+
+            // A layer where everything failed only leads to mods that fail too, so it doesn't count as a wave
+            if (!wave.empty()) {
+                std::ranges::sort(wave, [&nodes](const std::size_t lhs, const std::size_t rhs) {
+                    if (nodes[lhs].priority != nodes[rhs].priority) {
+                        return nodes[lhs].priority > nodes[rhs].priority;
+                    }
+                    return nodes[lhs].name < nodes[rhs].name;
+                });
+                plan.waves.push_back(std::move(wave));
+            }
+
+            current = std::move(next);
+        }
+
+        // Anything never released is on a cycle or downstream of one
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (remaining[i] != 0) {
+                plan.errors.push_back(std::format("Mod '{}' is part of or depends on a dependency cycle: {}",
+                                                  nodes[i].name, describe_cycle(nodes, plan.dependencies,
+                                                                                remaining, i)));
+            }
+        }
+
+        return plan;
+    }
+
+    std::string ModGraph::describe_cycle(const std::vector<Node> &nodes,
+                                         const std::vector<std::vector<std::size_t> > &dependencies,
+                                         const std::vector<std::size_t> &remaining_degree,
+                                         std::size_t start) {
+        // Every unreleased mod has at least one unreleased dependency, so following them must close a loop
+        std::vector<std::size_t> path;
+        std::unordered_map<std::size_t, std::size_t> position;
+
+        auto node = start;
+        while (!position.contains(node)) {
+            position.emplace(node, path.size());
+            path.push_back(node);
+
+            const auto &edges = dependencies[node];
+            const auto next = std::ranges::find_if(edges, [&remaining_degree](const std::size_t dependency) {
+                return remaining_degree[dependency] != 0;
+            });
+            if (next == edges.end()) {
+                break;
+            }
+            node = *next;
+        }
+
+        std::string description;
+        for (auto i = position.contains(node) ? position[node] : 0; i < path.size(); ++i) {
+            description += nodes[path[i]].name;
+            description += " -> ";
+        }
+        description += nodes[node].name;
+        return description;
+    }
+}
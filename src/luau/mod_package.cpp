@@ -0,0 +1,301 @@
+#include "RobloxModLoader/luau/mod_package.hpp"
+
+#include <zlib.h>
+#include <luau/Bytecode.h>
+
+namespace rml::luau {
+    namespace {
+        std::mutex g_open_packages_mutex;
+        std::unordered_map<std::string, std::weak_ptr<const ModPackage> > g_open_packages;
+
+        bool has_package_extension(const std::filesystem::path &path) {
+            const auto extension = path.extension().string();
+            return package_format::compare_paths(extension, package_format::EXTENSION) == 0;
+        }
+
+        std::uint32_t checksum(const std::string_view data) noexcept {
+            auto crc = crc32(0L, Z_NULL, 0);
+            crc = crc32(crc, reinterpret_cast<const Bytef *>(data.data()), static_cast<uInt>(data.size()));
+            return static_cast<std::uint32_t>(crc);
+        }
+    }
+
+    ModPackage::~ModPackage() {
+        if (m_view) {
+            UnmapViewOfFile(m_view);
+        }
+    }
+
+    std::expected<std::shared_ptr<const ModPackage>, std::string> ModPackage::open(const std::filesystem::path &path) {
+        std::error_code ec;
+        const auto absolute_path = std::filesystem::absolute(path, ec).lexically_normal();
+        const auto write_time = std::filesystem::last_write_time(absolute_path, ec);
+        if (ec) {
+            return std::unexpected(std::format("Cannot access package '{}': {}", path.string(), ec.message()));
+        }
+
+        const auto key = absolute_path.string();
+
+        std::lock_guard lock(g_open_packages_mutex);
+
+        if (const auto it = g_open_packages.find(key); it != g_open_packages.end()) {
+            if (auto package = it->second.lock(); package && package->m_write_time == write_time) {
+                return package;
+            }
+        }
+
+        auto package = map(absolute_path);
+        if (!package) {
+            return std::unexpected(package.error());
+        }
+
+        (*package)->m_write_time = write_time;
+        g_open_packages[key] = *package;
+
+        // Drop entries whose packages were released
+        std::erase_if(g_open_packages, [](const auto &entry) { return entry.second.expired(); });
+
+        LOG_DEBUG("Mapped mod package '{}' ({} entries, {} bytes)",
+                  absolute_path.string(), (*package)->m_entries.size(), (*package)->m_size);
+        return std::shared_ptr<const ModPackage>(std::move(*package));
+    }
+
+    std::optional<ModPackage::PackagedPath> ModPackage::resolve(const std::filesystem::path &path) {
+        std::filesystem::path package_path;
+        std::string entry_path;
+        bool inside_package = false;
+
+        for (const auto &component: path) {
+            if (inside_package) {
+                if (!entry_path.empty()) {
+                    entry_path += '/';
+                }
+                entry_path += component.string();
+                continue;
+            }
+
+            package_path /= component;
+            if (has_package_extension(component) && is_package_path(package_path)) {
+                inside_package = true;
+            }
+        }
+
+        if (!inside_package || entry_path.empty()) {
+            return std::nullopt;
+        }
+
+        auto package = open(package_path);
+        if (!package) {
+            LOG_WARN("{}", package.error());
+            return std::nullopt;
+        }
+
+        return PackagedPath{.package = std::move(*package), .entry_path = std::move(entry_path)};
+    }
+
+    bool ModPackage::is_package_path(const std::filesystem::path &path) noexcept {
+        try {
+            std::error_code ec;
+            return has_package_extension(path) && std::filesystem::is_regular_file(path, ec);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    const ModPackage::Entry *ModPackage::find(const std::string_view entry_path,
+                                              const package_format::EntryKind kind) const noexcept {
+        const auto it = std::lower_bound(m_entries.begin(), m_entries.end(), entry_path,
+                                         [this, kind](const Entry &entry, const std::string_view target) {
+                                             if (entry.kind != kind) {
+                                                 return entry.kind < kind;
+                                             }
+                                             return package_format::compare_paths(path_of(entry), target) < 0;
+                                         });
+
+        if (it == m_entries.end() || it->kind != kind ||
+            package_format::compare_paths(path_of(*it), entry_path) != 0) {
+            return nullptr;
+        }
+
+        return &*it;
+    }
+
+    std::string_view ModPackage::path_of(const Entry &entry) const noexcept {
+        return m_strings.substr(entry.path_offset, entry.path_size);
+    }
+
+    std::expected<std::string, std::string> ModPackage::read(const Entry &entry) const {
+        const std::string_view stored(reinterpret_cast<const char *>(m_view + entry.data_offset), entry.stored_size);
+
+        std::string contents;
+        switch (entry.compression) {
+            case package_format::Compression::Stored:
+                contents.assign(stored);
+                break;
+
+            case package_format::Compression::Zlib: {
+                contents.resize(entry.size);
+                auto size = static_cast<uLongf>(entry.size);
+                if (const auto result = uncompress(reinterpret_cast<Bytef *>(contents.data()), &size,
+                                                   reinterpret_cast<const Bytef *>(stored.data()),
+                                                   static_cast<uLong>(stored.size()));
+                    result != Z_OK || size != entry.size) {
+                    return std::unexpected(std::format("Failed to decompress '{}' from '{}' (zlib error {})",
+                                                       path_of(entry), m_path.string(), result));
+                }
+                break;
+            }
+
+            default:
+                return std::unexpected(std::format("Unknown compression for '{}' in '{}'",
+                                                   path_of(entry), m_path.string()));
+        }
+
+        if (checksum(contents) != entry.crc32) {
+            return std::unexpected(std::format("Checksum mismatch for '{}' in '{}'", path_of(entry), m_path.string()));
+        }
+
+        return contents;
+    }
+
+    std::expected<std::string, std::string> ModPackage::read(const std::string_view entry_path) const {
+        const auto entry = find(entry_path);
+        if (!entry) {
+            return std::unexpected(std::format("'{}' not found in '{}'", entry_path, m_path.string()));
+        }
+
+        return read(*entry);
+    }
+
+    std::optional<std::string> ModPackage::read_bytecode(const std::string_view entry_path,
+                                                         const Luau::CompileOptions &options) const {
+        const auto entry = find(entry_path, package_format::EntryKind::Bytecode);
+        if (!entry || entry->optimization_level != options.optimizationLevel ||
+            entry->debug_level != options.debugLevel || entry->bytecode_version != LBC_VERSION_TARGET) {
+            return std::nullopt;
+        }
+
+        auto bytecode = read(*entry);
+        if (!bytecode) {
+            LOG_WARN("{}", bytecode.error());
+            return std::nullopt;
+        }
+
+        return std::move(*bytecode);
+    }
+
+    std::string_view ModPackage::manifest() const noexcept {
+        const auto entry = find(package_format::MANIFEST_PATH, package_format::EntryKind::Manifest);
+        if (!entry || entry->compression != package_format::Compression::Stored) {
+            return {};
+        }
+
+        return {reinterpret_cast<const char *>(m_view + entry->data_offset), entry->stored_size};
+    }
+
+    std::expected<std::shared_ptr<ModPackage>, std::string> ModPackage::map(const std::filesystem::path &path) {
+        const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return std::unexpected(std::format("Failed to open package '{}' (error {})", path.string(),
+                                               GetLastError()));
+        }
+
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(
+                sizeof(package_format::Header)) ||
+            static_cast<std::uint64_t>(file_size.QuadPart) > std::numeric_limits<std::size_t>::max()) {
+            CloseHandle(file);
+            return std::unexpected(std::format("Package '{}' has an invalid size", path.string()));
+        }
+
+        const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return std::unexpected(std::format("Failed to map package '{}' (error {})", path.string(),
+                                               GetLastError()));
+        }
+
+        // The view keeps the mapping alive on its own
+        const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view) {
+            return std::unexpected(std::format("Failed to map package '{}' (error {})", path.string(),
+                                               GetLastError()));
+        }
+
+        std::shared_ptr<ModPackage> package(new ModPackage());
+        package->m_path = path;
+        package->m_view = static_cast<const std::byte *>(view);
+        package->m_size = static_cast<std::size_t>(file_size.QuadPart);
+
+        if (auto valid = package->validate(); !valid) {
+            return std::unexpected(std::format("Invalid package '{}': {}", path.string(), valid.error()));
+        }
+
+        return package;
+    }
+
+    std::expected<void, std::string> ModPackage::validate() {
+        m_header = reinterpret_cast<const package_format::Header *>(m_view);
+
+        if (m_header->magic != package_format::MAGIC) {
+            return std::unexpected("not an .rmlpkg file");
+        }
+
+        if (m_header->version != package_format::VERSION) {
+            return std::unexpected(std::format("unsupported version {}", m_header->version));
+        }
+
+        const auto in_bounds = [this](const std::uint64_t offset, const std::uint64_t size) {
+            return offset <= m_size && size <= m_size - offset;
+        };
+
+        const auto index_size = static_cast<std::uint64_t>(m_header->entry_count) * sizeof(Entry);
+        if (!in_bounds(m_header->index_offset, index_size) || m_header->index_offset % alignof(Entry) != 0) {
+            return std::unexpected("index out of bounds");
+        }
+
+        if (!in_bounds(m_header->strings_offset, m_header->strings_size)) {
+            return std::unexpected("string table out of bounds");
+        }
+
+        m_entries = {
+            reinterpret_cast<const Entry *>(m_view + m_header->index_offset),
+            static_cast<std::size_t>(m_header->entry_count)
+        };
+        m_strings = {
+            reinterpret_cast<const char *>(m_view + m_header->strings_offset),
+            static_cast<std::size_t>(m_header->strings_size)
+        };
+
+        // Checked once here so lookups and reads can trust the index
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            const auto &entry = m_entries[i];
+
+            if (!in_bounds(entry.data_offset, entry.stored_size) ||
+                !in_bounds(m_header->strings_offset + entry.path_offset, entry.path_size) ||
+                entry.path_offset + static_cast<std::uint64_t>(entry.path_size) > m_strings.size()) {
+                return std::unexpected(std::format("entry {} out of bounds", i));
+            }
+
+            // read() sizes its buffer from entry.size before inflating, so it has to be plausible
+            if (entry.compression == package_format::Compression::Zlib
+                    ? entry.size > entry.stored_size * package_format::MAX_DEFLATE_RATIO
+                    : entry.size != entry.stored_size) {
+                return std::unexpected(std::format("entry {} has an impossible size", i));
+            }
+
+            if (i > 0) {
+                const auto &previous = m_entries[i - 1];
+                if (previous.kind > entry.kind || (previous.kind == entry.kind &&
+                                                   package_format::compare_paths(
+                                                       path_of(previous), path_of(entry)) >= 0)) {
+                    return std::unexpected("index is not sorted");
+                }
+            }
+        }
+
+        return {};
+    }
+}
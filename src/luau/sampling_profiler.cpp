@@ -0,0 +1,460 @@
+#include "RobloxModLoader/common.hpp"
+#include "RobloxModLoader/luau/sampling_profiler.hpp"
+
+#include "utils/directory_utils.hpp"
+
+namespace rml::luau {
+    namespace {
+        // How often the timer thread folds queued samples
+        constexpr std::chrono::milliseconds AGGREGATE_INTERVAL{50};
+
+        constexpr std::string_view UNSCHEDULED_MOD = "<unscheduled>";
+
+        // Always id 0, so a full label table still has somewhere to put new frames
+        constexpr std::string_view TRUNCATED_FRAME = "<truncated>";
+        constexpr std::uint32_t TRUNCATED_ID = 0;
+
+        constexpr int MOD_FRAME = std::numeric_limits<int>::min();
+
+        struct FrameKey {
+            const void *name;
+            const void *source;
+            int line;
+
+            [[nodiscard]] bool operator==(const FrameKey &) const noexcept = default;
+        };
+
+        struct FrameKeyHash {
+            std::size_t operator()(const FrameKey &key) const noexcept {
+                auto hash = std::hash<const void *>{}(key.name);
+                hash ^= std::hash<const void *>{}(key.source) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                hash ^= std::hash<int>{}(key.line) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                return hash;
+            }
+        };
+
+        struct CachedFrame {
+            std::uint32_t id;
+            std::string name;
+            std::string source;
+        };
+
+        // Luau reuses a collected function's memory, so a hit is only trusted if its strings still match
+        struct FrameCache {
+            std::uint32_t generation{0};
+            std::unordered_map<FrameKey, CachedFrame, FrameKeyHash> frames;
+        };
+
+        thread_local FrameCache t_frame_cache;
+
+        void append_json_string(std::string &out, const std::string_view value) {
+            out += '"';
+            for (const char c: value) {
+                switch (c) {
+                    case '"':
+                        out += "\\\"";
+                        break;
+                    case '\\':
+                        out += "\\\\";
+                        break;
+                    case '\n':
+                        out += "\\n";
+                        break;
+                    case '\r':
+                        out += "\\r";
+                        break;
+                    case '\t':
+                        out += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+                        } else {
+                            out += c;
+                        }
+                        break;
+                }
+            }
+            out += '"';
+        }
+
+        // Collapsed stack frames are separated by ';' and end at the last space
+        void append_collapsed_frame(std::string &out, const std::string_view frame) {
+            for (const char c: frame) {
+                out += c == ';' ? ':' : c;
+            }
+        }
+    }
+
+    SamplingProfiler::SamplingProfiler()
+        : m_epoch(std::chrono::steady_clock::now()) {
+        m_names.emplace_back(TRUNCATED_FRAME);
+    }
+
+    SamplingProfiler::~SamplingProfiler() noexcept {
+        stop();
+    }
+
+    SamplingProfiler &SamplingProfiler::instance() noexcept {
+        static SamplingProfiler profiler;
+        return profiler;
+    }
+
+    std::expected<void, std::string> SamplingProfiler::start(const std::chrono::microseconds interval) {
+        if (interval < MIN_INTERVAL) {
+            return std::unexpected(std::format("Sampling interval must be at least {}us", MIN_INTERVAL.count()));
+        }
+
+        std::lock_guard lock(m_control_mutex);
+
+        if (m_worker.joinable()) {
+            m_worker.request_stop();
+            m_worker.join();
+        }
+
+        m_interval.store(interval.count(), std::memory_order_relaxed);
+        m_worker = std::jthread([this, interval](const std::stop_token stop_token) {
+            run(stop_token, interval);
+        });
+
+        LOG_INFO("Luau sampling profiler started ({}us interval)", interval.count());
+        return {};
+    }
+
+    void SamplingProfiler::stop() noexcept {
+        std::lock_guard lock(m_control_mutex);
+
+        if (!m_worker.joinable()) {
+            return;
+        }
+
+        m_worker.request_stop();
+        m_worker.join();
+        m_interval.store(0, std::memory_order_relaxed);
+
+        LOG_INFO("Luau sampling profiler stopped after {} samples", m_sample_count.load(std::memory_order_relaxed));
+    }
+
+    void SamplingProfiler::reset() noexcept {
+        {
+            // The timer thread is the queue's only consumer while it runs; it folds what's queued soon enough
+            std::lock_guard control_lock(m_control_mutex);
+            if (!m_worker.joinable()) {
+                while (m_samples.try_pop()) {
+                }
+            }
+        }
+
+        std::scoped_lock lock(m_data_mutex, m_names_mutex);
+        m_stack_counts.clear();
+        m_trace.clear();
+
+        // Samples still queued refer to the old labels; aggregate() drops them by generation
+        m_name_ids.clear();
+        m_names.clear();
+        m_names.emplace_back(TRUNCATED_FRAME);
+        m_generation.fetch_add(1, std::memory_order_release);
+
+        m_sample_count.store(0, std::memory_order_relaxed);
+        m_dropped_count.store(0, std::memory_order_relaxed);
+    }
+
+    SamplingProfiler::Statistics SamplingProfiler::get_statistics() const {
+        Statistics stats;
+        stats.running = is_running();
+        stats.interval = std::chrono::microseconds(m_interval.load(std::memory_order_relaxed));
+        stats.samples = m_sample_count.load(std::memory_order_relaxed);
+        stats.dropped_samples = m_dropped_count.load(std::memory_order_relaxed);
+
+        std::lock_guard lock(m_data_mutex);
+        stats.unique_stacks = m_stack_counts.size();
+        return stats;
+    }
+
+    std::uint32_t SamplingProfiler::intern(const std::string_view name) {
+        std::lock_guard lock(m_names_mutex);
+
+        if (const auto it = m_name_ids.find(name); it != m_name_ids.end()) {
+            return it->second;
+        }
+
+        if (m_names.size() >= MAX_NAMES) {
+            return TRUNCATED_ID;
+        }
+
+        const auto id = static_cast<std::uint32_t>(m_names.size());
+        m_names.emplace_back(name);
+        m_name_ids.emplace(std::string(name), id);
+        return id;
+    }
+
+    std::uint32_t SamplingProfiler::intern_frame(const std::uint32_t generation, const void *name_key,
+                                                 const void *source_key, const int line, const std::string_view name,
+                                                 const std::string_view source) {
+        auto &cache = t_frame_cache;
+        if (cache.generation != generation) {
+            cache.frames.clear();
+            cache.generation = generation;
+        }
+
+        const FrameKey key{name_key, source_key, line};
+        if (const auto it = cache.frames.find(key);
+            it != cache.frames.end() && it->second.name == name && it->second.source == source) {
+            return it->second.id;
+        }
+
+        const auto id = line == MOD_FRAME
+                            ? intern(name)
+                            : line >= 0
+                                  ? intern(std::format("{} ({}:{})", name, source, line))
+                                  : intern(std::format("{} [C]", name));
+
+        // A truncated label is looked up again, in case a reset made room
+        if (id != TRUNCATED_ID) {
+            cache.frames.insert_or_assign(key, CachedFrame{id, std::string(name), std::string(source)});
+        }
+        return id;
+    }
+
+    void SamplingProfiler::sample(lua_State *L, const std::string_view mod_name) noexcept {
+        try {
+            const auto generation = m_generation.load(std::memory_order_acquire);
+            const auto mod = mod_name.empty() ? UNSCHEDULED_MOD : mod_name;
+
+            Sample sample;
+            sample.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_epoch).count();
+            sample.generation = generation;
+            sample.thread_id = static_cast<std::uint32_t>(GetCurrentThreadId());
+            sample.mod_id = intern_frame(generation, mod.data(), nullptr, MOD_FRAME, mod, {});
+
+            // lua_getinfo counts levels from the running function outwards
+            std::array<std::uint32_t, MAX_STACK_DEPTH> inner_first{};
+            std::uint32_t depth = 0;
+
+            lua_Debug ar{};
+            for (int level = 0; depth < MAX_STACK_DEPTH && lua_getinfo(L, level, "sln", &ar); ++level) {
+                const std::string_view name = ar.name ? ar.name : "<anonymous>";
+                inner_first[depth++] = intern_frame(generation, ar.name, ar.source, ar.currentline, name,
+                                                    ar.short_src);
+            }
+
+            if (depth == 0) {
+                return;
+            }
+
+            sample.depth = depth;
+            std::reverse_copy(inner_first.begin(), inner_first.begin() + depth, sample.frames.begin());
+
+            if (!m_samples.try_push(std::move(sample))) {
+                m_dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            m_sample_count.fetch_add(1, std::memory_order_relaxed);
+        } catch (...) {
+            m_dropped_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void SamplingProfiler::run(const std::stop_token stop_token, const std::chrono::microseconds interval) {
+        std::mutex wait_mutex;
+        std::condition_variable_any wake;
+        auto last_aggregate = std::chrono::steady_clock::now();
+
+        while (!stop_token.stop_requested()) {
+            // 0 means stopped, so skip it when the tick wraps
+            if (s_tick.fetch_add(1, std::memory_order_relaxed) == std::numeric_limits<std::uint32_t>::max()) {
+                s_tick.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (const auto now = std::chrono::steady_clock::now(); now - last_aggregate >= AGGREGATE_INTERVAL) {
+                last_aggregate = now;
+                aggregate();
+            }
+
+            std::unique_lock lock(wait_mutex);
+            wake.wait_for(lock, stop_token, interval, [] { return false; });
+        }
+
+        s_tick.store(0, std::memory_order_relaxed);
+        aggregate();
+    }
+
+    void SamplingProfiler::aggregate() {
+        try {
+            std::lock_guard lock(m_data_mutex);
+            const auto generation = m_generation.load(std::memory_order_relaxed);
+
+            while (auto sample = m_samples.try_pop()) {
+                if (sample->generation != generation) {
+                    continue;
+                }
+
+                std::vector<std::uint32_t> stack;
+                stack.reserve(sample->depth + 1);
+                stack.push_back(sample->mod_id);
+                stack.insert(stack.end(), sample->frames.begin(), sample->frames.begin() + sample->depth);
+
+                ++m_stack_counts[stack];
+
+                if (m_trace.size() >= MAX_TRACE_SAMPLES) {
+                    m_trace.pop_front();
+                }
+                m_trace.push_back(TraceSample{sample->timestamp, sample->thread_id, std::move(stack)});
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to aggregate profiler samples: {}", e.what());
+        }
+    }
+
+    std::string SamplingProfiler::export_collapsed() const {
+        using StackCount = std::pair<std::vector<std::uint32_t>, std::uint64_t>;
+
+        // Copied out together so the ids match the labels; formatting then holds neither lock
+        std::vector<StackCount> stacks;
+        std::vector<std::string> names;
+        {
+            std::scoped_lock lock(m_data_mutex, m_names_mutex);
+            stacks.assign(m_stack_counts.begin(), m_stack_counts.end());
+            names = m_names;
+        }
+
+        std::ranges::sort(stacks, std::ranges::greater{}, &StackCount::second);
+
+        std::string out;
+        for (const auto &[stack, count]: stacks) {
+            for (std::size_t i = 0; i < stack.size(); ++i) {
+                if (i > 0) {
+                    out += ';';
+                }
+                append_collapsed_frame(out, names[stack[i]]);
+            }
+            std::format_to(std::back_inserter(out), " {}\n", count);
+        }
+
+        return out;
+    }
+
+    std::string SamplingProfiler::export_chrome_trace() const {
+        std::vector<TraceSample> samples;
+        std::vector<std::string> names;
+        {
+            std::scoped_lock lock(m_data_mutex, m_names_mutex);
+            samples.assign(m_trace.begin(), m_trace.end());
+            names = m_names;
+        }
+
+        std::ranges::stable_sort(samples, [](const TraceSample &a, const TraceSample &b) {
+            return a.thread_id != b.thread_id ? a.thread_id < b.thread_id : a.timestamp < b.timestamp;
+        });
+
+        const auto interval = std::max<std::int64_t>(m_interval.load(std::memory_order_relaxed),
+                                                     DEFAULT_INTERVAL.count());
+        const auto process_id = GetCurrentProcessId();
+
+        std::string out = R"({"displayTimeUnit":"ms","traceEvents":[)";
+        bool first_event = true;
+
+        const auto emit = [&](const std::uint32_t name_id, const std::int64_t start, const std::int64_t end,
+                              const std::uint32_t thread_id) {
+            out += first_event ? "" : ",";
+            first_event = false;
+            out += R"({"name":)";
+            append_json_string(out, names[name_id]);
+            std::format_to(std::back_inserter(out), R"(,"cat":"luau","ph":"X","ts":{},"dur":{},"pid":{},"tid":{}}})",
+                           start, std::max<std::int64_t>(end - start, 1), process_id, thread_id);
+        };
+
+        // Frames stay open while consecutive samples of a thread share them; a gap of more than two intervals
+        // means the thread left Luau, so everything open ends one interval after the last sample
+        struct OpenFrame {
+            std::uint32_t name_id;
+            std::int64_t start;
+        };
+
+        std::vector<OpenFrame> open;
+        std::uint32_t current_thread = 0;
+        std::int64_t last_timestamp = 0;
+
+        const auto close_from = [&](const std::size_t depth, const std::int64_t end) {
+            while (open.size() > depth) {
+                emit(open.back().name_id, open.back().start, end, current_thread);
+                open.pop_back();
+            }
+        };
+
+        for (const auto &sample: samples) {
+            if (!open.empty() && (sample.thread_id != current_thread ||
+                                  sample.timestamp - last_timestamp > interval * 2)) {
+                close_from(0, last_timestamp + interval);
+            }
+
+            current_thread = sample.thread_id;
+
+            std::size_t common = 0;
+            while (common < open.size() && common < sample.stack.size() &&
+                   open[common].name_id == sample.stack[common]) {
+                ++common;
+            }
+
+            close_from(common, sample.timestamp);
+            for (std::size_t i = common; i < sample.stack.size(); ++i) {
+                open.push_back(OpenFrame{sample.stack[i], sample.timestamp});
+            }
+
+            last_timestamp = sample.timestamp;
+        }
+
+        close_from(0, last_timestamp + interval);
+
+        out += "]}";
+        return out;
+    }
+
+    std::string SamplingProfiler::export_as(const ExportFormat format) const {
+        return format == ExportFormat::ChromeTrace ? export_chrome_trace() : export_collapsed();
+    }
+
+    std::expected<std::filesystem::path, std::string> SamplingProfiler::save(
+        const ExportFormat format, const std::filesystem::path &path) const {
+        try {
+            auto target = path;
+            if (target.empty()) {
+                const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+                target = directory_utils::get_module_directory() / "profiles" /
+                         std::format("luau_profile_{:%Y%m%d_%H%M%S}.{}", now,
+                                     format == ExportFormat::ChromeTrace ? "json" : "folded");
+            }
+
+            if (target.has_parent_path()) {
+                std::filesystem::create_directories(target.parent_path());
+            }
+
+            std::ofstream file(target, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                return std::unexpected(std::format("Failed to open {}", target.string()));
+            }
+
+            const auto data = export_as(format);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file) {
+                return std::unexpected(std::format("Failed to write {}", target.string()));
+            }
+
+            LOG_INFO("Saved Luau profile to {}", target.string());
+            return target;
+        } catch (const std::exception &e) {
+            return std::unexpected(std::format("Failed to save profile: {}", e.what()));
+        }
+    }
+
+    std::optional<SamplingProfiler::ExportFormat> SamplingProfiler::parse_format(const std::string_view name) noexcept {
+        if (name == "collapsed" || name == "folded" || name == "flamegraph") {
+            return ExportFormat::Collapsed;
+        }
+        if (name == "chrome" || name == "trace" || name == "json") {
+            return ExportFormat::ChromeTrace;
+        }
+        return std::nullopt;
+    }
+}
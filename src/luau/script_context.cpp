@@ -3,6 +3,8 @@
 #include "lobject.h"
 #include "RobloxModLoader/luau/script_context.hpp"
 
+#include "RobloxModLoader/luau/execution_monitor.hpp"
+#include "RobloxModLoader/luau/sampling_profiler.hpp"
 #include "RobloxModLoader/luau/environment/environment.hpp"
 #include "RobloxModLoader/roblox/luau/roblox_extra_space.hpp"
 #include "RobloxModLoader/roblox/security/script_permissions.hpp"
@@ -25,6 +27,14 @@ namespace rml::luau {
             // Setup all global providers
             environment::setup_lua_environment(m_context.L);
 
+            ExecutionMonitor::install(m_context.L);
+
+            if (config::core().performance.enable_profiling && !SamplingProfiler::instance().is_running()) {
+                if (const auto started = SamplingProfiler::instance().start(); !started) {
+                    LOG_ERROR("Failed to start the Luau profiler: {}", started.error());
+                }
+            }
+
             LOG_INFO("Execution context initialized successfully");
             return true;
         } catch (const std::exception &e) {
@@ -1,6 +1,7 @@
 #include "RobloxModLoader/luau/script_engine.hpp"
 
 #include "pointers.hpp"
+#include "RobloxModLoader/luau/bytecode_cache.hpp"
 #include "RobloxModLoader/luau/script_context.hpp"
 #include "RobloxModLoader/luau/script_scheduler.hpp"
 #include "RobloxModLoader/luau/environment/environment.hpp"
@@ -68,94 +69,128 @@ namespace rml::luau {
         }
     }
 
-    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_script(
+    util::Task<ScriptEngine::ExecutionResult> ScriptEngine::execute_script_task(
         const std::string_view source_code,
         const std::string_view chunk_name,
         const RBX::Security::Permissions security_level) const noexcept {
-        return execute_internal(
-            [source_code = std::string(source_code), chunk_name](lua_State *L) -> int {
-                constexpr auto compilation_opts = Luau::CompileOptions{
-                    .optimizationLevel = 1,
-                    .debugLevel = 2,
-                };
-
-                const auto bytecode = Luau::compile(source_code, compilation_opts);
-
-                if (bytecode.empty()) {
-                    lua_pushstring(L, "Failed to compile source code");
-                    return -1;
+        return execute_internal_task(
+            [source_code, chunk_name](lua_State *L) -> int {
+                const auto bytecode = compile_cached(source_code, MOD_COMPILE_OPTIONS);
+
+                if (BytecodeCache::is_compile_error(*bytecode)) {
+                    const auto message = BytecodeCache::compile_error_message(*bytecode);
+                    lua_pushlstring(L, message.data(), message.size());
+                    return LUA_ERRSYNTAX;
                 }
 
                 const auto chunk_name_str = std::format("={}", chunk_name);
 
-                return g_pointers->m_roblox_pointers.luau_load(L, chunk_name_str.c_str(), bytecode.data(),
-                                                               bytecode.size(), 0);
+                return g_pointers->m_roblox_pointers.luau_load(L, chunk_name_str.c_str(), bytecode->data(),
+                                                               bytecode->size(), 0);
             },
             chunk_name,
+            nullptr,
             security_level
         );
     }
 
-    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_script_with_context(
+    util::Task<ScriptEngine::ExecutionResult> ScriptEngine::execute_script_with_context_task(
         const std::string_view source_code,
         const std::string_view chunk_name,
         const environment::RMLProvider::ModContext &mod_context,
         const RBX::Security::Permissions security_level) const noexcept {
-        return execute_internal_with_context(
-            [source_code = std::string(source_code), chunk_name](lua_State *L) -> int {
-                constexpr auto compilation_opts = Luau::CompileOptions{
-                    .optimizationLevel = 1,
-                    .debugLevel = 2,
-                };
-
-                const auto bytecode = Luau::compile(source_code, compilation_opts);
-
-                if (bytecode.empty()) {
-                    lua_pushstring(L, "Failed to compile source code");
-                    return -1;
+        return execute_internal_task(
+            [source_code, chunk_name](lua_State *L) -> int {
+                const auto bytecode = compile_cached(source_code, MOD_COMPILE_OPTIONS);
+
+                if (BytecodeCache::is_compile_error(*bytecode)) {
+                    const auto message = BytecodeCache::compile_error_message(*bytecode);
+                    lua_pushlstring(L, message.data(), message.size());
+                    return LUA_ERRSYNTAX;
                 }
 
                 const auto chunk_name_str = std::format("={}", chunk_name);
 
-                return g_pointers->m_roblox_pointers.luau_load(L, chunk_name_str.c_str(), bytecode.data(),
-                                                               bytecode.size(), 0);
+                return g_pointers->m_roblox_pointers.luau_load(L, chunk_name_str.c_str(), bytecode->data(),
+                                                               bytecode->size(), 0);
             },
             chunk_name,
-            mod_context,
+            &mod_context,
             security_level
         );
     }
 
-    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_bytecode(
+    util::Task<ScriptEngine::ExecutionResult> ScriptEngine::execute_internal_with_context_task(
+        const std::function<int(lua_State *)> &loader,
+        const std::string_view chunk_name,
+        const environment::RMLProvider::ModContext &mod_context,
+        const RBX::Security::Permissions security_level) const noexcept {
+        return execute_internal_task(loader, chunk_name, &mod_context, security_level);
+    }
+
+    util::Task<ScriptEngine::ExecutionResult> ScriptEngine::execute_bytecode_task(
         std::span<const std::byte> bytecode,
         const std::string_view chunk_name,
         const RBX::Security::Permissions security_level) const noexcept {
-        return execute_internal(
+        return execute_internal_task(
             [bytecode](lua_State *L) -> int {
                 return g_pointers->m_roblox_pointers.luau_load(L, "=rml_bytecode",
                                                                reinterpret_cast<const char *>(bytecode.data()),
                                                                bytecode.size(), 0);
             },
             chunk_name,
+            nullptr,
             security_level
         );
     }
 
+    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_script(
+        const std::string_view source_code,
+        const std::string_view chunk_name,
+        const RBX::Security::Permissions security_level) const noexcept {
+        return util::to_future(execute_script_task(source_code, chunk_name, security_level));
+    }
+
+    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_script_with_context(
+        const std::string_view source_code,
+        const std::string_view chunk_name,
+        const environment::RMLProvider::ModContext &mod_context,
+        const RBX::Security::Permissions security_level) const noexcept {
+        return util::to_future(execute_script_with_context_task(source_code, chunk_name, mod_context,
+                                                                security_level));
+    }
+
+    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_internal_with_context(
+        const std::function<int(lua_State *)> &loader,
+        const std::string_view chunk_name,
+        const environment::RMLProvider::ModContext &mod_context,
+        const RBX::Security::Permissions security_level) const noexcept {
+        return util::to_future(execute_internal_task(loader, chunk_name, &mod_context, security_level));
+    }
+
+    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_bytecode(
+        std::span<const std::byte> bytecode,
+        const std::string_view chunk_name,
+        const RBX::Security::Permissions security_level) const noexcept {
+        return util::to_future(execute_bytecode_task(bytecode, chunk_name, security_level));
+    }
+
     std::expected<std::vector<std::byte>, std::string> ScriptEngine::compile_script(
-        const std::string_view source_code) noexcept {
+        const std::string_view source_code,
+        const std::filesystem::path &mod_path) noexcept {
         try {
             constexpr auto compilation_opts = Luau::CompileOptions{};
 
-            const auto bytecode = Luau::compile(std::string(source_code), compilation_opts);
+            const auto bytecode = compile_cached(source_code, compilation_opts, mod_path);
 
-            if (bytecode.empty()) {
-                return std::unexpected("Failed to compile source code");
+            if (BytecodeCache::is_compile_error(*bytecode)) {
+                return std::unexpected(std::string(BytecodeCache::compile_error_message(*bytecode)));
             }
 
             std::vector<std::byte> result;
-            result.reserve(bytecode.size());
+            result.reserve(bytecode->size());
 
-            std::ranges::transform(bytecode, std::back_inserter(result),
+            std::ranges::transform(*bytecode, std::back_inserter(result),
                                    [](char c) { return static_cast<std::byte>(c); });
 
             return result;
@@ -172,6 +207,10 @@ namespace rml::luau {
         return *m_scheduler;
     }
 
+    ScriptScheduler &ScriptEngine::get_scheduler() noexcept {
+        return *m_scheduler;
+    }
+
     bool ScriptEngine::is_running() const noexcept {
         return m_is_running.load(std::memory_order_acquire);
     }
@@ -204,140 +243,74 @@ namespace rml::luau {
         };
     }
 
-    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_internal(
+    util::Task<ScriptEngine::ExecutionResult> ScriptEngine::execute_internal_task(
         const std::function<int(lua_State *)> &loader,
         const std::string_view chunk_name,
+        const environment::RMLProvider::ModContext *mod_context,
         const RBX::Security::Permissions security_level) const noexcept {
-        auto promise = std::make_shared<std::promise<ExecutionResult> >();
-        auto future = promise->get_future();
-
         try {
             if (!is_running()) {
-                promise->set_value(ExecutionResult{
+                return util::make_ready_task(ExecutionResult{
                     .success = false,
                     .error_message = "Execution engine is not running"
                 });
-                return future;
             }
 
             auto context = std::make_unique<ScriptScheduler::ExecutionContext>();
-            context->L = lua_newthread(m_context->get_thread_state());
+            context->L = mod_context && mod_context->mod_thread
+                             ? mod_context->mod_thread
+                             : lua_newthread(m_context->get_thread_state());
             context->chunk_name = std::string(chunk_name);
             context->security_level = security_level;
             context->priority = ScriptScheduler::Priority::Normal;
             context->scheduled_time = std::chrono::steady_clock::now();
 
+            if (mod_context) {
+                context->mod_name = mod_context->mod_name;
+                context->mod_weight = ScriptScheduler::weight_for_priority(mod_context->mod_priority);
+            }
+
             ScriptContext::set_thread_identity(context->L, context->security_level, RBX::Security::FULL_CAPABILITIES);
 
+            if (mod_context) {
+                environment::RMLProvider::set_mod_context(context->L, *mod_context);
+            }
+
             const auto start_time = std::chrono::high_resolution_clock::now();
 
             if (const int load_result = loader(context->L); load_result != LUA_OK) {
-                const std::string error_msg = lua_tostring(context->L, -1);
-
-                promise->set_value(ExecutionResult{
+                return util::make_ready_task(ExecutionResult{
                     .success = false,
-                    .error_message = error_msg
+                    .error_message = lua_tostring(context->L, -1)
                 });
-                return future;
             }
 
-            auto completion_future = m_scheduler->schedule_script(std::move(context));
-
-            std::thread([promise, completion_future = std::move(completion_future), start_time]() mutable {
-                try {
-                    completion_future.wait();
-                    const auto end_time = std::chrono::high_resolution_clock::now();
-
-                    promise->set_value(ExecutionResult{
-                        .success = true,
-                        .execution_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            end_time - start_time)
-                    });
-                } catch (const std::exception &e) {
-                    promise->set_value(ExecutionResult{
-                        .success = false,
-                        .error_message = e.what()
-                    });
-                }
-            }).detach();
+            return await_execution(std::move(context), start_time);
         } catch (const std::exception &e) {
-            promise->set_value(ExecutionResult{
+            return util::make_ready_task(ExecutionResult{
                 .success = false,
                 .error_message = std::format("Internal execution error: {}", e.what())
             });
         }
-
-        return future;
     }
 
-    std::future<ScriptEngine::ExecutionResult> ScriptEngine::execute_internal_with_context(
-        const std::function<int(lua_State *)> &loader,
-        const std::string_view chunk_name,
-        const environment::RMLProvider::ModContext &mod_context,
-        const RBX::Security::Permissions security_level) const noexcept {
-        auto promise = std::make_shared<std::promise<ExecutionResult> >();
-        auto future = promise->get_future();
-
-        try {
-            if (!is_running()) {
-                promise->set_value(ExecutionResult{
-                    .success = false,
-                    .error_message = "Execution engine is not running"
-                });
-                return future;
-            }
-
-            auto context = std::make_unique<ScriptScheduler::ExecutionContext>();
-            context->L = mod_context.mod_thread
-                             ? mod_context.mod_thread
-                             : lua_newthread(m_context->get_thread_state());
-            context->chunk_name = std::string(chunk_name);
-            context->security_level = security_level;
-            context->priority = ScriptScheduler::Priority::Normal;
-            context->scheduled_time = std::chrono::steady_clock::now();
-
-            ScriptContext::set_thread_identity(context->L, context->security_level, RBX::Security::FULL_CAPABILITIES);
-
-            environment::RMLProvider::set_mod_context(context->L, mod_context);
+    util::Task<ScriptEngine::ExecutionResult> ScriptEngine::await_execution(
+        std::unique_ptr<ScriptScheduler::ExecutionContext> context,
+        const std::chrono::high_resolution_clock::time_point start_time) const {
+        // The completion slot lives in this frame; no promise or waiting thread per execution
+        const auto completed = co_await m_scheduler->schedule(std::move(context));
+        const auto end_time = std::chrono::high_resolution_clock::now();
 
-            const auto start_time = std::chrono::high_resolution_clock::now();
-
-            if (const int load_result = loader(context->L); load_result != LUA_OK) {
-                const std::string error_msg = lua_tostring(context->L, -1);
-
-                promise->set_value(ExecutionResult{
-                    .success = false,
-                    .error_message = error_msg
-                });
-                return future;
-            }
-
-            auto completion_future = m_scheduler->schedule_script(std::move(context));
-
-            std::thread([promise, completion_future = std::move(completion_future), start_time]() mutable {
-                try {
-                    completion_future.wait();
-                    const auto end_time = std::chrono::high_resolution_clock::now();
-
-                    promise->set_value(ExecutionResult{
-                        .success = true,
-                        .execution_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            end_time - start_time)
-                    });
-                } catch (const std::exception &e) {
-                    promise->set_value(ExecutionResult{
-                        .success = false,
-                        .error_message = e.what()
-                    });
-                }
-            }).detach();
-        } catch (const std::exception &e) {
-            promise->set_value(ExecutionResult{
+        if (!completed) {
+            co_return ExecutionResult{
                 .success = false,
-                .error_message = std::format("Internal execution error: {}", e.what())
-            });
+                .error_message = completed.error()
+            };
         }
 
-        return future;
+        co_return ExecutionResult{
+            .success = true,
+            .execution_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time)
+        };
     }
 }
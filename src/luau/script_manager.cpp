@@ -5,10 +5,95 @@
 #include "RobloxModLoader/config/config.hpp"
 #include "RobloxModLoader/config/config_helpers.hpp"
 #include "RobloxModLoader/roblox/task_scheduler.hpp"
+#include "RobloxModLoader/luau/bytecode_cache.hpp"
+#include "RobloxModLoader/luau/mod_graph.hpp"
 #include "RobloxModLoader/luau/environment/environment.hpp"
 #include "pointers.hpp"
+#include "RobloxModLoader/util/glob_pattern.hpp"
+
+#include <numeric>
 
 namespace rml::luau {
+    namespace {
+        struct ScriptFile {
+            std::filesystem::path path;
+            std::filesystem::path mod_path;
+            std::shared_ptr<const ModPackage> package;
+            std::string entry_path; // Inside package
+            std::string content;
+            BytecodeCache::Bytecode bytecode;
+            bool valid{false};
+        };
+
+        // Runs one pipeline stage across the pool and adds its wall and summed task time to stage.
+        template<typename Items, typename Fn>
+        void run_stage(util::ThreadPool &pool, Items &items, ScriptManager::LoadTimings::Stage &stage, Fn &&fn) {
+            const auto stage_start = std::chrono::steady_clock::now();
+            std::atomic<std::chrono::nanoseconds::rep> busy{0};
+
+            pool.for_each(items, [&fn, &busy](auto &item) {
+                const auto task_start = std::chrono::steady_clock::now();
+                fn(item);
+                busy.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - task_start).count(),
+                               std::memory_order_relaxed);
+            });
+
+            stage.wall += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - stage_start);
+            stage.busy += std::chrono::nanoseconds{busy.load(std::memory_order_relaxed)};
+            stage.items += std::ranges::size(items);
+        }
+
+        double to_milliseconds(const std::chrono::nanoseconds value) {
+            return std::chrono::duration<double, std::milli>(value).count();
+        }
+
+        // Name a mod is registered under: its directory name, or the file stem of a package
+        std::string mod_id_of(const std::filesystem::path &mod_path) {
+            return ModPackage::is_package_path(mod_path) ? mod_path.stem().string() : mod_path.filename().string();
+        }
+
+        // Case-insensitive like the file system, so "Main.LUA" runs too
+        bool has_script_extension(const std::filesystem::path &path) {
+            const auto extension = path.extension().string();
+            return package_format::compare_paths(extension, ".lua") == 0 ||
+                   package_format::compare_paths(extension, ".luau") == 0;
+        }
+
+        // Counts a script against its rollout wave for as long as it lives
+        class InFlightScope final {
+        public:
+            explicit InFlightScope(std::shared_ptr<std::atomic<std::size_t> > counter) noexcept
+                : m_counter(std::move(counter)) {
+                if (m_counter) {
+                    m_counter->fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            ~InFlightScope() {
+                if (m_counter) {
+                    m_counter->fetch_sub(1, std::memory_order_release);
+                }
+            }
+
+            InFlightScope(const InFlightScope &) = delete;
+
+            InFlightScope &operator=(const InFlightScope &) = delete;
+
+        private:
+            std::shared_ptr<std::atomic<std::size_t> > m_counter;
+        };
+
+        // Result reported for a script whose execution task threw instead of completing
+        ScriptEngine::ExecutionResult failed_result(const std::exception_ptr &error) noexcept {
+            return ScriptEngine::ExecutionResult{
+                .success = false,
+                .error_message = std::format("Internal execution error: {}", util::describe_exception(error))
+            };
+        }
+    }
+
     ScriptManager::ScriptManager() {
         g_script_manager = this;
 
@@ -27,9 +112,11 @@ namespace rml::luau {
         // Initialize environment providers
         environment::initialize_default_providers();
 
-        if (config::is_debug_mode()) {
+        m_worker_pool = std::make_unique<util::ThreadPool>(config::core().performance.thread_pool_size);
+
+        if (config::is_debug_mode() || config::core().developer.enable_hot_reload) {
             m_hot_reload_enabled = true;
-            LOG_INFO("Hot reload enabled in debug mode");
+            LOG_INFO("Hot reload enabled");
         }
 
         for (const auto &mod: g_mod_manager->mods) {
@@ -48,6 +135,9 @@ namespace rml::luau {
     void ScriptManager::shutdown() {
         LOG_INFO("Shutting down mod script manager...");
 
+        // The watcher thread takes m_scripts_mutex, so it has to be joined first
+        stop_file_watcher();
+
         std::unique_lock lock(m_scripts_mutex);
 
         for (auto &mod_context: m_loaded_mods) {
@@ -55,6 +145,8 @@ namespace rml::luau {
         }
 
         m_loaded_mods.clear();
+        m_rollouts.clear();
+        m_pending_rollouts.store(0, std::memory_order_release);
 
         // Shutdown environment providers
         environment::shutdown_providers();
@@ -70,91 +162,402 @@ namespace rml::luau {
             return;
         }
 
+        std::vector<ModLoadRequest> requests;
+        for (const auto &entry: std::filesystem::directory_iterator(mods_directory)) {
+            if (entry.is_directory() || ModPackage::is_package_path(entry.path())) {
+                requests.push_back(ModLoadRequest{.mod_directory = entry.path()});
+            }
+        }
+
+        auto loaded_mods = run_load_pipeline(std::move(requests));
+
+        {
+            std::unique_lock lock(m_scripts_mutex);
+            m_loaded_mods = std::move(loaded_mods);
+            m_mods_directory = mods_directory;
+
+            LOG_INFO("Loaded scripts for {} mods", m_loaded_mods.size());
+        }
+
+        if (m_hot_reload_enabled) {
+            start_file_watcher();
+        }
+    }
+
+    void ScriptManager::load_mod_scripts_for_context(const std::filesystem::path &mod_directory,
+                                                     const config::ModConfig &mod_config) {
+        std::unordered_set<std::string> already_loaded;
+        {
+            std::shared_lock lock(m_scripts_mutex);
+            for (const auto &mod_context: m_loaded_mods) {
+                already_loaded.insert(mod_id_of(mod_context.mod_path));
+                already_loaded.insert(mod_context.mod_name);
+            }
+        }
+
+        auto loaded_mods = run_load_pipeline({
+            ModLoadRequest{.mod_directory = mod_directory, .mod_config = mod_config}
+        }, already_loaded);
+
         std::unique_lock lock(m_scripts_mutex);
-        m_loaded_mods.clear();
+        std::ranges::move(loaded_mods, std::back_inserter(m_loaded_mods));
+    }
 
-        for (const auto &entry: std::filesystem::directory_iterator(mods_directory)) {
-            if (!entry.is_directory()) {
-                continue;
+    ScriptManager::LoadTimings ScriptManager::get_last_load_timings() const {
+        std::lock_guard lock(m_load_timings_mutex);
+        return m_last_load_timings;
+    }
+
+    std::vector<ScriptManager::ModThreadPoolStatistics> ScriptManager::get_thread_pool_statistics() const {
+        std::shared_lock lock(m_scripts_mutex);
+
+        std::vector<ModThreadPoolStatistics> statistics;
+        for (const auto &mod_context: m_loaded_mods) {
+            if (mod_context.thread_pool) {
+                statistics.push_back(ModThreadPoolStatistics{
+                    .mod_name = mod_context.mod_name,
+                    .statistics = mod_context.thread_pool->get_statistics()
+                });
             }
+        }
+        return statistics;
+    }
 
-            const auto &mod_directory = entry.path();
-            const auto mod_name = mod_directory.filename().string();
-            const auto config_path = mod_directory / "mod.toml";
+    std::vector<ModScriptContext> ScriptManager::run_load_pipeline(std::vector<ModLoadRequest> requests,
+                                                                   const std::unordered_set<std::string> &already_loaded) {
+        const auto pipeline_start = std::chrono::steady_clock::now();
+        LoadTimings timings;
 
-            if (!std::filesystem::exists(config_path)) {
-                LOG_WARN("No config.toml found for mod: {}", mod_name);
-                continue;
+        // Discover: parse mod.toml and resolve script patterns, one task per mod
+        std::vector<std::optional<ModScriptContext> > discovered(requests.size());
+        std::vector<std::size_t> request_indices(requests.size());
+        std::iota(request_indices.begin(), request_indices.end(), std::size_t{0});
+
+        run_stage(*m_worker_pool, request_indices, timings.discover, [&](const std::size_t index) {
+            try {
+                auto &request = requests[index];
+                const auto mod_name = mod_id_of(request.mod_directory);
+
+                // A package is mapped once here; its manifest, scripts and bytecode are all read from the mapping
+                std::shared_ptr<const ModPackage> package;
+                if (ModPackage::is_package_path(request.mod_directory)) {
+                    auto opened = ModPackage::open(request.mod_directory);
+                    if (!opened) {
+                        LOG_ERROR("Failed to open package for mod '{}': {}", mod_name, opened.error());
+                        return;
+                    }
+                    package = std::move(*opened);
+                }
+
+                if (!request.mod_config && package) {
+                    const auto manifest = package->manifest();
+                    if (manifest.empty()) {
+                        LOG_WARN("No mod.toml found in package for mod: {}", mod_name);
+                        return;
+                    }
+
+                    if (const auto config_result = config::helpers::load_mod_config_from_string(
+                        mod_name, manifest); !config_result) {
+                        LOG_ERROR("Failed to load config for mod: {}", mod_name);
+                        return;
+                    }
+
+                    request.mod_config = config::mod(mod_name);
+                    if (!request.mod_config) {
+                        LOG_ERROR("Failed to get loaded config for mod: {}", mod_name);
+                        return;
+                    }
+                }
+
+                if (!request.mod_config) {
+                    const auto config_path = request.mod_directory / "mod.toml";
+
+                    if (!std::filesystem::exists(config_path)) {
+                        LOG_WARN("No config.toml found for mod: {}", mod_name);
+                        return;
+                    }
+
+                    // Load mod configuration
+                    if (const auto config_result = config::helpers::load_mod_config_from_file(
+                        mod_name, config_path); !config_result) {
+                        LOG_ERROR("Failed to load config for mod: {}", mod_name);
+                        return;
+                    }
+
+                    request.mod_config = config::mod(mod_name);
+                    if (!request.mod_config) {
+                        LOG_ERROR("Failed to get loaded config for mod: {}", mod_name);
+                        return;
+                    }
+                }
+
+                discovered[index] = discover_mod_scripts(request.mod_directory, *request.mod_config, package);
+            } catch (const std::exception &e) {
+                LOG_ERROR("Failed to discover scripts in '{}': {}", requests[index].mod_directory.string(), e.what());
             }
+        });
 
-            // Load mod configuration
-            if (const auto config_result = config::helpers::load_mod_config_from_file(mod_name, config_path); !
-                config_result) {
-                LOG_ERROR("Failed to load config for mod: {}", mod_name);
+        // Order: mods whose dependencies are missing or cyclic are dropped before any of their files are read
+        std::vector<std::size_t> graph_requests;
+        std::vector<ModGraph::Node> graph_nodes;
+        for (std::size_t i = 0; i < discovered.size(); ++i) {
+            if (!discovered[i]) {
                 continue;
             }
 
-            const auto mod_config = config::mod(mod_name);
-            if (!mod_config) {
-                LOG_ERROR("Failed to get loaded config for mod: {}", mod_name);
+            const auto &mod_config = *requests[i].mod_config;
+            graph_requests.push_back(i);
+            graph_nodes.push_back(ModGraph::Node{
+                .id = mod_id_of(requests[i].mod_directory),
+                .name = mod_config.name,
+                .priority = mod_config.runtime.priority,
+                .dependencies = mod_config.runtime.dependencies
+            });
+        }
+
+        const auto plan = ModGraph::solve(graph_nodes, already_loaded);
+        for (const auto &error: plan.errors) {
+            LOG_ERROR("{}", error);
+        }
+
+        for (std::size_t node = 0; node < graph_nodes.size(); ++node) {
+            if (plan.is_rejected(node)) {
+                discovered[graph_requests[node]].reset();
+            }
+        }
+
+        if (!plan.waves.empty()) {
+            std::size_t widest = 0;
+            for (const auto &wave: plan.waves) {
+                widest = std::max(widest, wave.size());
+            }
+
+            LOG_INFO("Mod dependency order: {} mods in {} waves (widest wave {} mods)",
+                     graph_nodes.size() - std::ranges::count(plan.wave_of, ModGraph::REJECTED),
+                     plan.waves.size(), widest);
+        }
+
+        // A file matched by several contexts is read and compiled once
+        std::unordered_map<std::string, ScriptFile> files_by_path;
+        for (const auto &mod_context: discovered) {
+            if (!mod_context) {
                 continue;
             }
+            for (const auto &scripts: mod_context->scripts_by_context | std::views::values) {
+                for (const auto &script_info: scripts) {
+                    auto &file = files_by_path[script_info.full_path.string()];
+                    file.path = script_info.full_path;
+
+                    if (script_info.package) {
+                        file.package = script_info.package;
+                        file.entry_path = script_info.full_path.lexically_relative(script_info.mod_path).generic_string();
+                    } else {
+                        file.mod_path = script_info.mod_path; // Packages have no directory for the disk cache
+                    }
+                }
+            }
+        }
 
-            load_mod_scripts_for_context(mod_directory, *mod_config);
+        std::vector<ScriptFile *> files;
+        files.reserve(files_by_path.size());
+        for (auto &file: files_by_path | std::views::values) {
+            files.push_back(&file);
         }
 
-        LOG_INFO("Loaded scripts for {} mods", m_loaded_mods.size());
+        std::atomic<std::size_t> bytes_read{0};
+        run_stage(*m_worker_pool, files, timings.read, [&bytes_read](ScriptFile *file) {
+            if (file->package) {
+                auto content = file->package->read(file->entry_path);
+                if (!content) {
+                    LOG_ERROR("Failed to load script: {}", content.error());
+                    return;
+                }
+                file->content = std::move(*content);
+
+                if (auto bytecode = file->package->read_bytecode(file->entry_path, MOD_COMPILE_OPTIONS)) {
+                    file->bytecode = std::make_shared<const std::string>(std::move(*bytecode));
+                }
+            } else {
+                file->content = load_script_content(file->path);
+            }
+            bytes_read.fetch_add(file->content.size(), std::memory_order_relaxed);
+        });
+        timings.bytes_read = bytes_read.load(std::memory_order_relaxed);
+
+        run_stage(*m_worker_pool, files, timings.compile, [](ScriptFile *file) {
+            if (file->content.empty() || file->bytecode) {
+                return; // Unreadable, or precompiled in its package
+            }
+
+            try {
+                file->bytecode = compile_cached(file->content, MOD_COMPILE_OPTIONS, file->mod_path);
+            } catch (const std::exception &e) {
+                LOG_ERROR("Failed to compile script '{}': {}", file->path.string(), e.what());
+            }
+        });
+
+        // Verify: compile errors come back as bytecode holding the message, report them here rather than at
+        // execution time
+        run_stage(*m_worker_pool, files, timings.verify, [](ScriptFile *file) {
+            if (!file->bytecode || file->bytecode->empty()) {
+                return;
+            }
+
+            if (BytecodeCache::is_compile_error(*file->bytecode)) {
+                LOG_ERROR("Failed to compile script '{}': {}",
+                          file->path.string(), BytecodeCache::compile_error_message(*file->bytecode));
+                return;
+            }
+
+            file->valid = true;
+        });
+
+        std::vector<ModScriptContext> loaded_mods;
+        for (std::size_t wave = 0; wave < plan.waves.size(); ++wave) {
+            for (const auto node: plan.waves[wave]) {
+                auto &mod_context = discovered[graph_requests[node]];
+                mod_context->load_wave = wave;
+                loaded_mods.push_back(std::move(*mod_context));
+            }
+        }
+
+        for (auto &mod_context: loaded_mods) {
+            for (auto &[data_model_type, scripts]: mod_context.scripts_by_context) {
+                std::erase_if(scripts, [&files_by_path](ScriptInfo &script_info) {
+                    const auto &file = files_by_path[script_info.full_path.string()];
+                    if (!file.valid) {
+                        return true;
+                    }
+
+                    script_info.content = file.content;
+                    script_info.bytecode = file.bytecode;
+                    script_info.package.reset();
+                    return false;
+                });
+
+                LOG_INFO("Loaded {} scripts for mod: {} (DataModel type: {})",
+                         scripts.size(), mod_context.mod_name, static_cast<int>(data_model_type));
+            }
+
+            mod_context.loaded = true;
+        }
+
+        timings.total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - pipeline_start);
+
+        LOG_INFO("Mod load pipeline: {} mods, {} files, {} bytes in {:.2f}ms "
+                 "(discover {:.2f}ms, read {:.2f}ms, compile {:.2f}ms, verify {:.2f}ms; compile busy {:.2f}ms on {} workers)",
+                 loaded_mods.size(), files.size(), timings.bytes_read, to_milliseconds(timings.total),
+                 to_milliseconds(timings.discover.wall), to_milliseconds(timings.read.wall),
+                 to_milliseconds(timings.compile.wall), to_milliseconds(timings.verify.wall),
+                 to_milliseconds(timings.compile.busy), m_worker_pool->size());
+
+        {
+            std::lock_guard lock(m_load_timings_mutex);
+            m_last_load_timings = timings;
+        }
+
+        return loaded_mods;
     }
 
-    void ScriptManager::load_mod_scripts_for_context(const std::filesystem::path &mod_directory,
-                                                     const config::ModConfig &mod_config) {
+    std::optional<ModScriptContext> ScriptManager::discover_mod_scripts(const std::filesystem::path &mod_directory,
+                                                                        const config::ModConfig &mod_config,
+                                                                        const std::shared_ptr<const ModPackage> &package) {
         LOG_INFO("Loading scripts for mod: {}", mod_config.name);
 
         const auto scripts_directory = mod_directory / "scripts";
-        if (!std::filesystem::exists(scripts_directory)) {
+        if (!package && !std::filesystem::exists(scripts_directory)) {
             LOG_WARN("Scripts directory not found for mod: {}", mod_config.name);
-            return;
+            return std::nullopt;
         }
 
         ModScriptContext mod_context;
         mod_context.mod_name = mod_config.name;
         mod_context.mod_path = mod_directory;
-
-        // Load scripts for each DataModel context
-        if (!mod_config.datamodel_context.standalone.empty()) {
-            auto scripts = resolve_script_patterns(scripts_directory, mod_config.datamodel_context.standalone,
-                                                   mod_config);
-            mod_context.scripts_by_context[RBX::DataModelType::Standalone] = std::move(scripts);
-            LOG_INFO("Loaded {} standalone scripts for mod: {}",
-                     mod_context.scripts_by_context[RBX::DataModelType::Standalone].size(), mod_config.name);
+        mod_context.is_package = package != nullptr;
+        mod_context.dependencies = mod_config.runtime.dependencies;
+
+        // The mod may ask for less than the core cap, never more
+        mod_context.memory_limit = config::core().security.max_memory_per_mod;
+        if (const auto requested = mod_config.resources.max_memory_usage) {
+            mod_context.memory_limit = mod_context.memory_limit
+                                           ? std::min(mod_context.memory_limit, *requested)
+                                           : *requested;
         }
+        mod_context.execution_limit = mod_config.resources.max_execution_time.value_or(std::chrono::milliseconds{0});
+
+        const std::array<std::pair<RBX::DataModelType, const std::vector<std::string> *>, 4> contexts{{
+            {RBX::DataModelType::Standalone, &mod_config.datamodel_context.standalone},
+            {RBX::DataModelType::Edit, &mod_config.datamodel_context.edit},
+            {RBX::DataModelType::Client, &mod_config.datamodel_context.client},
+            {RBX::DataModelType::Server, &mod_config.datamodel_context.server},
+        }};
+
+        // Every (context, pattern) pair is compiled once and matched during a single walk of scripts/
+        struct ContextPattern {
+            RBX::DataModelType data_model_type;
+            util::GlobPattern glob;
+            std::vector<std::filesystem::path> matches;
+        };
+
+        std::vector<ContextPattern> context_patterns;
+        for (const auto &[data_model_type, patterns]: contexts) {
+            for (const auto &pattern: *patterns) {
+                auto glob = util::GlobPattern::compile(pattern);
+                if (!glob) {
+                    LOG_WARN("Invalid pattern in mod '{}': {}", mod_config.name, glob.error());
+                    continue;
+                }
 
-        if (!mod_config.datamodel_context.edit.empty()) {
-            auto scripts =
-                    resolve_script_patterns(scripts_directory, mod_config.datamodel_context.edit, mod_config);
-            mod_context.scripts_by_context[RBX::DataModelType::Edit] = std::move(scripts);
-            LOG_INFO("Loaded {} edit scripts for mod: {}",
-                     mod_context.scripts_by_context[RBX::DataModelType::Edit].size(), mod_config.name);
+                context_patterns.push_back(ContextPattern{
+                    .data_model_type = data_model_type,
+                    .glob = std::move(*glob)
+                });
+            }
         }
 
-        if (!mod_config.datamodel_context.client.empty()) {
-            auto scripts = resolve_script_patterns(scripts_directory, mod_config.datamodel_context.client,
-                                                   mod_config);
-            mod_context.scripts_by_context[RBX::DataModelType::Client] = std::move(scripts);
-            LOG_INFO("Loaded {} client scripts for mod: {}",
-                     mod_context.scripts_by_context[RBX::DataModelType::Client].size(), mod_config.name);
+        if (!context_patterns.empty()) {
+            const auto script_files = package
+                                          ? list_package_script_files(*package, mod_directory)
+                                          : list_script_files(scripts_directory);
+
+            for (const auto &[full_path, relative_path]: script_files) {
+                for (auto &context_pattern: context_patterns) {
+                    if (context_pattern.glob.matches(relative_path)) {
+                        context_pattern.matches.push_back(full_path);
+                    }
+                }
+            }
         }
 
-        if (!mod_config.datamodel_context.server.empty()) {
-            auto scripts = resolve_script_patterns(scripts_directory, mod_config.datamodel_context.server,
-                                                   mod_config);
-            mod_context.scripts_by_context[RBX::DataModelType::Server] = std::move(scripts);
-            LOG_INFO("Loaded {} server scripts for mod: {}",
-                     mod_context.scripts_by_context[RBX::DataModelType::Server].size(), mod_config.name);
+        // Keep pattern order within a context; a file matched by several patterns of one context runs once
+        for (const auto &[data_model_type, patterns]: contexts) {
+            if (patterns->empty()) {
+                continue;
+            }
+
+            auto &scripts = mod_context.scripts_by_context[data_model_type];
+            std::unordered_set<std::filesystem::path> seen;
+
+            for (const auto &context_pattern: context_patterns) {
+                if (context_pattern.data_model_type != data_model_type) {
+                    continue;
+                }
+
+                for (const auto &file_path: context_pattern.matches) {
+                    if (seen.insert(file_path).second) {
+                        scripts.push_back(make_script_info(context_pattern.glob.pattern(), file_path, mod_config,
+                                                           mod_directory));
+                        scripts.back().package = package;
+                    }
+                }
+            }
+
+            LOG_DEBUG("Found {} scripts for mod: {} (DataModel type: {})",
+                      scripts.size(), mod_config.name, static_cast<int>(data_model_type));
         }
 
-        mod_context.loaded = true;
-        m_loaded_mods.push_back(std::move(mod_context));
+        return mod_context;
     }
 
     void ScriptManager::execute_scripts_for_context(RBX::DataModelType data_model_type) {
@@ -162,37 +565,106 @@ namespace rml::luau {
 
         LOG_INFO("Executing scripts for DataModel type: {}", static_cast<int>(data_model_type));
 
-        for (auto &mod_context: m_loaded_mods) {
-            if (!mod_context.loaded) {
-                continue;
+        auto &rollout = m_rollouts[data_model_type];
+        rollout = ScriptRollout{.in_flight = std::make_shared<std::atomic<std::size_t> >(0)};
+
+        if (!schedule_next_wave(data_model_type, rollout)) {
+            m_rollouts.erase(data_model_type);
+        }
+        m_pending_rollouts.store(m_rollouts.size(), std::memory_order_release);
+    }
+
+    void ScriptManager::advance_script_waves(const RBX::DataModelType data_model_type) {
+        if (!has_pending_script_waves()) {
+            return;
+        }
+
+        std::unique_lock lock(m_scripts_mutex);
+
+        const auto it = m_rollouts.find(data_model_type);
+        if (it == m_rollouts.end() || it->second.in_flight->load(std::memory_order_acquire) != 0) {
+            return;
+        }
+
+        if (!schedule_next_wave(data_model_type, it->second)) {
+            LOG_INFO("All script waves finished for DataModel type: {}", static_cast<int>(data_model_type));
+            m_rollouts.erase(it);
+            m_pending_rollouts.store(m_rollouts.size(), std::memory_order_release);
+        }
+    }
+
+    bool ScriptManager::schedule_next_wave(const RBX::DataModelType data_model_type, ScriptRollout &rollout) {
+        for (;;) {
+            // Reloaded mods are appended at the end, so m_loaded_mods isn't strictly sorted by wave
+            auto wave = std::numeric_limits<std::size_t>::max();
+            for (const auto &mod_context: m_loaded_mods) {
+                if (mod_context.loaded && mod_context.load_wave >= rollout.next_wave &&
+                    mod_context.scripts_by_context.contains(data_model_type)) {
+                    wave = std::min(wave, mod_context.load_wave);
+                }
             }
 
-            const auto it = mod_context.scripts_by_context.find(data_model_type);
-            if (it == mod_context.scripts_by_context.end()) {
-                continue;
+            if (wave == std::numeric_limits<std::size_t>::max()) {
+                return false;
             }
 
-            if (!mod_context.mod_thread) {
-                mod_context.mod_thread = create_mod_thread(data_model_type, mod_context.mod_name);
-                if (!mod_context.mod_thread) {
-                    LOG_ERROR("Failed to create dedicated thread for mod: {}", mod_context.mod_name);
-                    continue;
+            rollout.next_wave = wave + 1;
+            std::size_t scheduled = 0;
+
+            for (auto &mod_context: m_loaded_mods) {
+                if (mod_context.loaded && mod_context.load_wave == wave) {
+                    scheduled += schedule_mod_scripts(mod_context, data_model_type, rollout.in_flight);
                 }
-                LOG_INFO("Created dedicated sandboxed thread for mod: {}", mod_context.mod_name);
             }
 
-            LOG_INFO("Scheduling {} scripts for mod: {} (DataModel type: {}) using dedicated thread",
-                     it->second.size(), mod_context.mod_name, static_cast<int>(data_model_type));
+            // Nothing to wait for, move straight on to the following wave
+            if (scheduled > 0) {
+                return true;
+            }
+        }
+    }
+
+    std::size_t ScriptManager::schedule_mod_scripts(ModScriptContext &mod_context,
+                                                    const RBX::DataModelType data_model_type,
+                                                    const std::shared_ptr<std::atomic<std::size_t> > &in_flight) {
+        const auto it = mod_context.scripts_by_context.find(data_model_type);
+        if (it == mod_context.scripts_by_context.end()) {
+            return 0;
+        }
 
-            for (auto &script_info: it->second) {
-                try {
-                    schedule_script_with_mod_thread(data_model_type, script_info, mod_context.mod_thread);
-                } catch (const std::exception &e) {
-                    LOG_ERROR("Failed to schedule script '{}' for mod '{}': {}",
-                              script_info.pattern, mod_context.mod_name, e.what());
+        if (!mod_context.mod_thread) {
+            mod_context.mod_thread = create_mod_thread(data_model_type, mod_context.mod_name,
+                                                         mod_context.memory_limit, mod_context.execution_limit);
+            if (!mod_context.mod_thread) {
+                LOG_ERROR("Failed to create dedicated thread for mod: {}", mod_context.mod_name);
+                return 0;
+            }
+            mod_context.engine = g_task_scheduler->get_script_engine(data_model_type);
+            LOG_INFO("Created dedicated sandboxed thread for mod: {}", mod_context.mod_name);
+        }
+
+        if (!mod_context.thread_pool) {
+            mod_context.thread_pool = std::make_unique<LuaThreadPool>(
+                mod_context.mod_thread, config::core().performance.max_idle_lua_threads);
+        }
+
+        LOG_INFO("Scheduling {} scripts for mod: {} (DataModel type: {}, wave {}) using dedicated thread",
+                 it->second.size(), mod_context.mod_name, static_cast<int>(data_model_type), mod_context.load_wave);
+
+        std::size_t scheduled = 0;
+        for (auto &script_info: it->second) {
+            try {
+                if (schedule_script_with_mod_thread(data_model_type, script_info, mod_context.thread_pool.get(),
+                                                    in_flight)) {
+                    ++scheduled;
                 }
+            } catch (const std::exception &e) {
+                LOG_ERROR("Failed to schedule script '{}' for mod '{}': {}",
+                          script_info.pattern, mod_context.mod_name, e.what());
             }
         }
+
+        return scheduled;
     }
 
     void ScriptManager::reload_mod_scripts(const std::string &mod_name) {
@@ -228,35 +700,279 @@ namespace rml::luau {
         LOG_INFO("Successfully reloaded scripts for mod: {}", mod_name);
     }
 
-    std::vector<ScriptInfo> ScriptManager::resolve_script_patterns(
-        const std::filesystem::path &scripts_directory,
-        const std::vector<std::string> &patterns,
-        const config::ModConfig &mod_config) {
-        std::vector<ScriptInfo> scripts;
-
-        for (const auto &pattern: patterns) {
-            for (const auto matching_files = find_matching_files(scripts_directory, {pattern}); const auto &
-                 file_path:
-                 matching_files) {
-                ScriptInfo script_info;
-                script_info.pattern = pattern;
-                script_info.full_path = file_path;
-                script_info.content = load_script_content(file_path);
-
-                script_info.mod_name = mod_config.name;
-                script_info.mod_version = mod_config.version;
-                script_info.mod_description = mod_config.description;
-                script_info.mod_author = mod_config.author;
-                script_info.mod_path = scripts_directory.parent_path();
-                //script_info.mod_dependencies = mod_config.dependencies; TODO: Future support for dependencies
-
-                if (!script_info.content.empty()) {
-                    scripts.push_back(std::move(script_info));
+    void ScriptManager::set_hot_reload_enabled(const bool enabled) noexcept {
+        m_hot_reload_enabled = enabled;
+
+        try {
+            if (enabled) {
+                start_file_watcher();
+            } else {
+                stop_file_watcher();
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to {} hot reload: {}", enabled ? "enable" : "disable", e.what());
+        }
+    }
+
+    void ScriptManager::start_file_watcher() {
+        std::lock_guard lock(m_file_watcher_mutex);
+
+        // Nothing to watch until load_mod_scripts has run
+        if (m_file_watcher || m_mods_directory.empty()) {
+            return;
+        }
+
+        m_file_watcher = std::make_unique<FileWatcher>(
+            std::vector{m_mods_directory},
+            [this](const std::vector<FileWatcher::Change> &changes) { on_files_changed(changes); },
+            FileWatcher::Options{});
+
+        LOG_INFO("Watching {} for script changes", m_mods_directory.string());
+    }
+
+    void ScriptManager::stop_file_watcher() {
+        std::unique_ptr<FileWatcher> file_watcher;
+        {
+            std::lock_guard lock(m_file_watcher_mutex);
+            file_watcher = std::move(m_file_watcher);
+        }
+
+        // Joined outside the lock; a running callback may still need m_scripts_mutex
+        file_watcher.reset();
+    }
+
+    void ScriptManager::on_files_changed(const std::vector<FileWatcher::Change> &changes) {
+        std::vector<std::filesystem::path> modified;
+        std::unordered_set<std::filesystem::path> mod_reloads;
+
+        for (const auto &[path, kind]: changes) {
+            const auto relative_path = path.lexically_relative(m_mods_directory);
+            if (relative_path.empty() || relative_path.begin() == relative_path.end()) {
+                continue;
+            }
+
+            // Each top level entry of the mods directory is one mod
+            const auto mod_path = m_mods_directory / *relative_path.begin();
+            const bool is_package = package_format::compare_paths(mod_path.extension().string(),
+                                                                  package_format::EXTENSION) == 0;
+            if (std::distance(relative_path.begin(), relative_path.end()) == 1 && !is_package) {
+                continue; // Loose file next to the mods
+            }
+
+            // Anything that can change which scripts a mod has, or how it's configured, reloads the whole mod
+            if (kind != FileWatcher::ChangeKind::Modified || is_package || path.filename() == "mod.toml") {
+                mod_reloads.insert(mod_path);
+            } else {
+                modified.push_back(path);
+            }
+        }
+
+        // Drop the changed modules from the shared store, then find every loaded script that runs one of
+        // them; modules that didn't change keep their compiled bytecode
+        const auto affected = environment::require_impl::g_module_graph.affected_by(modified);
+        for (const auto &path: modified) {
+            environment::require_impl::g_module_store.invalidate(
+                environment::require_impl::ModuleGraph::normalize(path));
+        }
+
+        std::vector<ScriptFile> files;
+        {
+            std::shared_lock lock(m_scripts_mutex);
+            std::unordered_set<std::filesystem::path> seen;
+
+            for (const auto &mod_context: m_loaded_mods) {
+                if (mod_context.is_package || mod_reloads.contains(mod_context.mod_path)) {
+                    continue; // Packages only change as a whole
+                }
+
+                for (const auto &scripts: mod_context.scripts_by_context | std::views::values) {
+                    for (const auto &script_info: scripts) {
+                        if (!seen.contains(script_info.full_path) &&
+                            affected.contains(environment::require_impl::ModuleGraph::normalize(
+                                script_info.full_path))) {
+                            seen.insert(script_info.full_path);
+                            files.push_back(ScriptFile{.path = script_info.full_path, .mod_path = mod_context.mod_path});
+                        }
+                    }
+                }
+            }
+        }
+
+        // Read and compile here so the game thread only swaps the results in
+        std::vector<StagedScript> staged;
+        for (auto &file: files) {
+            file.content = load_script_content(file.path);
+            if (file.content.empty()) {
+                continue;
+            }
+
+            file.bytecode = compile_cached(file.content, MOD_COMPILE_OPTIONS, file.mod_path);
+            if (!file.bytecode || BytecodeCache::is_compile_error(*file.bytecode)) {
+                LOG_ERROR("Failed to compile script '{}', keeping the previous version: {}", file.path.string(),
+                          file.bytecode ? BytecodeCache::compile_error_message(*file.bytecode) : std::string_view());
+                continue;
+            }
+
+            staged.push_back(StagedScript{
+                .full_path = std::move(file.path),
+                .content = std::move(file.content),
+                .bytecode = std::move(file.bytecode)
+            });
+        }
+
+        LOG_INFO("Hot reload: {} files changed, {} scripts updated, {} mods to reload",
+                 changes.size(), staged.size(), mod_reloads.size());
+
+        if (staged.empty() && mod_reloads.empty()) {
+            return;
+        }
+
+        std::lock_guard lock(m_hot_reload_mutex);
+        std::ranges::move(staged, std::back_inserter(m_staged_scripts));
+        m_pending_mod_reloads.merge(mod_reloads);
+        m_hot_reload_pending.store(true, std::memory_order_release);
+    }
+
+    void ScriptManager::process_hot_reloads() {
+        if (!m_hot_reload_pending.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        std::vector<StagedScript> staged;
+        std::unordered_set<std::filesystem::path> mod_reloads;
+        {
+            std::lock_guard lock(m_hot_reload_mutex);
+            staged.swap(m_staged_scripts);
+            mod_reloads.swap(m_pending_mod_reloads);
+        }
+
+        for (const auto &mod_path: mod_reloads) {
+            reload_mod_from_disk(mod_path);
+        }
+
+        if (staged.empty()) {
+            return;
+        }
+
+        std::unordered_map<std::filesystem::path, const StagedScript *> staged_by_path;
+        for (const auto &script: staged) {
+            staged_by_path[script.full_path] = &script;
+        }
+
+        std::unique_lock lock(m_scripts_mutex);
+        std::size_t restarted = 0;
+
+        for (auto &mod_context: m_loaded_mods) {
+            bool changed = false;
+            for (auto &scripts: mod_context.scripts_by_context | std::views::values) {
+                for (auto &script_info: scripts) {
+                    const auto it = staged_by_path.find(script_info.full_path);
+                    if (it == staged_by_path.end()) {
+                        continue;
+                    }
+
+                    script_info.content = it->second->content;
+                    script_info.bytecode = it->second->bytecode;
+                    changed = true;
+                }
+            }
+
+            // Scripts that haven't started yet pick the new version up when their wave runs. A running mod starts
+            // over on a new thread; re-running the script next to its old coroutines and listeners would leave
+            // both versions' handlers active.
+            if (changed && mod_context.mod_thread) {
+                cleanup_mod_thread(mod_context);
+                schedule_reloaded_mod(mod_context);
+                ++restarted;
+            }
+        }
+
+        LOG_INFO("Hot reload: restarted {} mods", restarted);
+    }
+
+    void ScriptManager::reload_mod_from_disk(const std::filesystem::path &mod_path) {
+        LOG_INFO("Reloading mod from disk: {}", mod_path.string());
+
+        std::unordered_set<std::string> already_loaded;
+        {
+            std::unique_lock lock(m_scripts_mutex);
+
+            if (const auto it = std::ranges::find(m_loaded_mods, mod_path, &ModScriptContext::mod_path);
+                it != m_loaded_mods.end()) {
+                cleanup_mod_thread(*it);
+                m_loaded_mods.erase(it);
+            }
+
+            for (const auto &mod_context: m_loaded_mods) {
+                already_loaded.insert(mod_id_of(mod_context.mod_path));
+                already_loaded.insert(mod_context.mod_name);
+            }
+        }
+
+        std::error_code ec;
+        if (!std::filesystem::exists(mod_path, ec)) {
+            LOG_INFO("Unloaded removed mod: {}", mod_path.string());
+            return;
+        }
+
+        // Unlike reload_mod_scripts, mod.toml is read again
+        auto loaded_mods = run_load_pipeline({ModLoadRequest{.mod_directory = mod_path}}, already_loaded);
+
+        std::unique_lock lock(m_scripts_mutex);
+        for (auto &mod_context: loaded_mods) {
+            schedule_reloaded_mod(mod_context);
+            m_loaded_mods.push_back(std::move(mod_context));
+        }
+    }
+
+    void ScriptManager::schedule_reloaded_mod(ModScriptContext &mod_context) {
+        // The pipeline only saw this mod, so its wave is 0; dependencies resolve against the loaded set
+        mod_context.load_wave = 0;
+        for (const auto &dependency: mod_context.dependencies) {
+            for (const auto &loaded: m_loaded_mods) {
+                if (loaded.mod_name == dependency || mod_id_of(loaded.mod_path) == dependency) {
+                    mod_context.load_wave = std::max(mod_context.load_wave, loaded.load_wave + 1);
                 }
             }
         }
 
-        return scripts;
+        for (const auto data_model_type: mod_context.scripts_by_context | std::views::keys) {
+            if (!g_task_scheduler || !g_task_scheduler->get_script_engine(data_model_type)) {
+                continue; // Runs with the rest once that DataModel's engine starts
+            }
+
+            // A rollout still short of the mod's wave schedules it when it gets there. Otherwise its dependencies
+            // have run, and it joins the rollout's current wave so the next one waits for it.
+            std::shared_ptr<std::atomic<std::size_t> > in_flight;
+            if (const auto it = m_rollouts.find(data_model_type); it != m_rollouts.end()) {
+                if (mod_context.load_wave >= it->second.next_wave) {
+                    continue;
+                }
+                in_flight = it->second.in_flight;
+            }
+
+            schedule_mod_scripts(mod_context, data_model_type, in_flight);
+        }
+    }
+
+    ScriptInfo ScriptManager::make_script_info(const std::string &pattern,
+                                               const std::filesystem::path &file_path,
+                                               const config::ModConfig &mod_config,
+                                               const std::filesystem::path &mod_path) {
+        ScriptInfo script_info;
+        script_info.pattern = pattern;
+        script_info.full_path = file_path;
+
+        script_info.mod_name = mod_config.name;
+        script_info.mod_version = mod_config.version;
+        script_info.mod_description = mod_config.description;
+        script_info.mod_author = mod_config.author;
+        script_info.mod_path = mod_path;
+        script_info.mod_priority = mod_config.runtime.priority;
+        script_info.mod_dependencies = mod_config.runtime.dependencies;
+
+        // Content and bytecode are filled in by the read and compile stages
+        return script_info;
     }
 
     std::string ScriptManager::load_script_content(const std::filesystem::path &script_path) {
@@ -285,74 +1001,13 @@ namespace rml::luau {
         }
     }
 
-    bool ScriptManager::matches_pattern(const std::filesystem::path &file_path, const std::string &pattern) {
-        const auto normalized_path = file_path.generic_string();
-
-        std::string regex_pattern;
-        bool in_double_star = false;
-
-        for (size_t i = 0; i < pattern.length(); ++i) {
-            switch (const auto c = pattern[i]) {
-                case '.':
-                case '^':
-                case '$':
-                case '+':
-                case '{':
-                case '}':
-                case '[':
-                case ']':
-                case '(':
-                case ')':
-                case '\\':
-                case '|':
-                    regex_pattern += '\\';
-                    regex_pattern += c;
-                    break;
-
-                case '*':
-                    if (i + 1 < pattern.length() && pattern[i + 1] == '*') {
-                        regex_pattern += ".*";
-                        in_double_star = true;
-                        ++i;
-                    } else {
-                        regex_pattern += "[^/]*";
-                    }
-                    break;
-
-                case '?':
-                    regex_pattern += "[^/]";
-                    break;
-
-                case '/':
-                    if (in_double_star) {
-                        in_double_star = false;
-                    }
-                    regex_pattern += '/';
-                    break;
-
-                default:
-                    regex_pattern += c;
-                    break;
-            }
-        }
-
-        try {
-            const std::regex pattern_regex(regex_pattern, std::regex_constants::icase);
-            return std::regex_match(normalized_path, pattern_regex);
-        } catch (const std::exception &e) {
-            LOG_WARN("Invalid pattern '{}': {}", pattern, e.what());
-            return false;
-        }
-    }
-
-    std::vector<std::filesystem::path> ScriptManager::find_matching_files(
-        const std::filesystem::path &directory,
-        const std::vector<std::string> &patterns) {
-        std::vector<std::filesystem::path> matching_files;
+    std::vector<ScriptManager::ScriptFileEntry> ScriptManager::list_script_files(
+        const std::filesystem::path &directory) {
+        std::vector<ScriptFileEntry> files;
 
         if (!std::filesystem::exists(directory)) {
             LOG_WARN("Directory does not exist: {}", directory.string());
-            return matching_files;
+            return files;
         }
 
         try {
@@ -362,25 +1017,50 @@ namespace rml::luau {
                 }
 
                 const auto &file_path = entry.path();
-                const auto relative_path = std::filesystem::relative(file_path, directory);
 
-                if (const auto extension = file_path.extension().string();
-                    extension != ".lua" && extension != ".luau") {
+                if (!has_script_extension(file_path)) {
                     continue;
                 }
 
-                for (const auto &pattern: patterns) {
-                    if (matches_pattern(relative_path, pattern)) {
-                        matching_files.push_back(file_path);
-                        break;
-                    }
-                }
+                files.push_back(ScriptFileEntry{
+                    .full_path = file_path,
+                    .relative_path = file_path.lexically_relative(directory).generic_string()
+                });
             }
         } catch (const std::exception &e) {
             LOG_ERROR("Error scanning directory '{}': {}", directory.string(), e.what());
         }
 
-        return matching_files;
+        // Directory iteration order is unspecified; sort so scripts run in the same order everywhere
+        std::ranges::sort(files, {}, &ScriptFileEntry::relative_path);
+        return files;
+    }
+
+    std::vector<ScriptManager::ScriptFileEntry> ScriptManager::list_package_script_files(
+        const ModPackage &package,
+        const std::filesystem::path &package_path) {
+        constexpr std::string_view scripts_prefix = "scripts/";
+        std::vector<ScriptFileEntry> files;
+
+        // The index is already sorted by path, which keeps the same order as a directory scan
+        for (const auto &entry: package.entries()) {
+            const auto entry_path = package.path_of(entry);
+            if (entry.kind != package_format::EntryKind::File ||
+                package_format::compare_paths(entry_path.substr(0, scripts_prefix.size()), scripts_prefix) != 0) {
+                continue;
+            }
+
+            if (!has_script_extension(entry_path)) {
+                continue;
+            }
+
+            files.push_back(ScriptFileEntry{
+                .full_path = package_path / entry_path,
+                .relative_path = std::string(entry_path.substr(scripts_prefix.size()))
+            });
+        }
+
+        return files;
     }
 
     void ScriptManager::schedule_script(const RBX::DataModelType data_model_type,
@@ -418,27 +1098,18 @@ namespace rml::luau {
                 .mod_description = script_info.mod_description,
                 .mod_author = script_info.mod_author,
                 .mod_path = script_info.mod_path,
-                .mod_dependencies = script_info.mod_dependencies
+                .mod_dependencies = script_info.mod_dependencies,
+                .mod_priority = script_info.mod_priority
             };
 
-            auto future = engine->execute_script_with_context(
-                script_info.content,
-                chunk_name,
-                mod_context
-            );
-
-            std::thread execution_thread([future = std::move(future), script_info]() mutable {
-                try {
-                    const auto result = future.get();
-                    handle_script_result(script_info, result);
-                } catch (const std::exception &e) {
-                    log_script_error(script_info, std::format("Exception during execution: {}", e.what()));
-                } catch (...) {
-                    log_script_error(script_info, "Unknown exception during execution");
-                }
-            });
-
-            execution_thread.detach();
+            // The engine is kept alive by the completion handler until the script has run
+            util::spawn(engine->execute_script_with_context_task(script_info.content, chunk_name, mod_context),
+                        [engine, script_info](const ScriptEngine::ExecutionResult &result) noexcept {
+                            handle_script_result(script_info, result);
+                        },
+                        [engine, script_info](const std::exception_ptr &error) noexcept {
+                            handle_script_result(script_info, failed_result(error));
+                        });
         } catch (const std::exception &e) {
             log_script_error(script_info, std::format("Failed to schedule script: {}", e.what()));
         } catch (...) {
@@ -467,24 +1138,25 @@ namespace rml::luau {
         }
     }
 
-    void ScriptManager::schedule_script_with_mod_thread(const RBX::DataModelType data_model_type,
+    bool ScriptManager::schedule_script_with_mod_thread(const RBX::DataModelType data_model_type,
                                                         const ScriptInfo &script_info,
-                                                        lua_State *mod_thread) {
+                                                        LuaThreadPool *thread_pool,
+                                                        const std::shared_ptr<std::atomic<std::size_t> > &in_flight) {
         if (!g_task_scheduler) {
             LOG_ERROR("TaskScheduler not available, cannot schedule script: {}",
                       script_info.full_path.string());
-            return;
+            return false;
         }
 
-        if (!mod_thread) {
+        if (!thread_pool) {
             LOG_ERROR("Mod thread is null, cannot schedule script: {}",
                       script_info.full_path.string());
-            return;
+            return false;
         }
 
         const auto engine = g_task_scheduler->get_script_engine(data_model_type);
         if (!engine) {
-            return;
+            return false;
         }
 
         const auto chunk_name = script_info.full_path.filename().string();
@@ -492,71 +1164,91 @@ namespace rml::luau {
         LOG_DEBUG("Scheduling script via ScriptEngine using dedicated mod thread: {}",
                   script_info.full_path.string());
 
-        execute_script_async_with_mod_thread(engine, script_info, chunk_name, mod_thread);
+        return execute_script_async_with_mod_thread(engine, script_info, chunk_name, thread_pool, in_flight);
     }
 
-    void ScriptManager::execute_script_async_with_mod_thread(const std::shared_ptr<ScriptEngine> &engine,
+    bool ScriptManager::execute_script_async_with_mod_thread(const std::shared_ptr<ScriptEngine> &engine,
                                                              const ScriptInfo &script_info,
                                                              const std::string &chunk_name,
-                                                             lua_State *mod_thread) noexcept {
+                                                             LuaThreadPool *thread_pool,
+                                                             std::shared_ptr<std::atomic<std::size_t> > in_flight) noexcept {
         if (!engine) [[unlikely]] {
             log_script_error(script_info, "Script engine is null");
-            return;
+            return false;
         }
 
-        if (!mod_thread) [[unlikely]] {
+        if (!thread_pool) [[unlikely]] {
             log_script_error(script_info, "Mod thread is null");
-            return;
+            return false;
         }
 
         try {
-            auto future = execute_script_in_mod_thread(engine, script_info, chunk_name, mod_thread);
-
-            std::thread execution_thread([future = std::move(future), script_info]() mutable {
-                try {
-                    const auto result = future.get();
-                    handle_script_result(script_info, result);
-                } catch (const std::exception &e) {
-                    log_script_error(script_info, std::format("Exception during execution: {}", e.what()));
-                } catch (...) {
-                    log_script_error(script_info, "Unknown exception during execution");
-                }
-            });
-
-            execution_thread.detach();
+            auto task = execute_script_in_mod_thread(engine, script_info, chunk_name, *thread_pool);
+
+            // Shared by both callbacks; the count drops once the task and its callbacks are gone, however it ended
+            const auto counted = std::make_shared<InFlightScope>(std::move(in_flight));
+
+            // Runs on the scheduler's thread once the script has been handed off; no waiting thread per script
+            util::spawn(std::move(task),
+                        [engine, script_info, counted](const ScriptEngine::ExecutionResult &result) noexcept {
+                            handle_script_result(script_info, result);
+                        },
+                        [engine, script_info, counted](const std::exception_ptr &error) noexcept {
+                            handle_script_result(script_info, failed_result(error));
+                        });
+            return true;
         } catch (const std::exception &e) {
             log_script_error(script_info, std::format("Failed to schedule script: {}", e.what()));
         } catch (...) {
             log_script_error(script_info, "Unknown error during script scheduling");
         }
+
+        return false;
     }
 
-    std::future<ScriptEngine::ExecutionResult> ScriptManager::execute_script_in_mod_thread(
+    util::Task<ScriptEngine::ExecutionResult> ScriptManager::execute_script_in_mod_thread(
         const std::shared_ptr<ScriptEngine> &engine,
         const ScriptInfo &script_info,
         const std::string &chunk_name,
-        lua_State *mod_thread) noexcept {
+        LuaThreadPool &thread_pool) noexcept {
         try {
-            auto script_thread = lua_newthread(mod_thread);
+            // A finished thread of this mod when one is idle, a new child of the mod thread otherwise
+            const auto script_thread = thread_pool.acquire();
+            if (!script_thread) {
+                throw std::runtime_error("Failed to acquire a Lua thread");
+            }
 
-            auto loader = [&script_info, &chunk_name, script_thread](lua_State *) -> int {
-                const auto compile_result = ScriptEngine::compile_script(script_info.content);
-                if (!compile_result) {
-                    LOG_ERROR("Failed to compile script '{}': {}",
-                              script_info.full_path.string(), compile_result.error());
+            bool loaded = false;
+            auto loader = [&script_info, &chunk_name, &thread_pool, script_thread, &loaded](lua_State *) -> int {
+                // Normally compiled and verified by the load pipeline; only compile here if it was skipped
+                const auto bytecode = script_info.bytecode
+                                          ? script_info.bytecode
+                                          : compile_cached(script_info.content, MOD_COMPILE_OPTIONS,
+                                                           script_info.mod_path);
+                if (BytecodeCache::is_compile_error(*bytecode)) {
+                    const auto message = BytecodeCache::compile_error_message(*bytecode);
+                    LOG_ERROR("Failed to compile script '{}': {}", script_info.full_path.string(), message);
+
+                    // The engine reports the error from the top of the stack, as for a failed luau_load
+                    lua_pushlstring(script_thread, message.data(), message.size());
                     return LUA_ERRSYNTAX;
                 }
 
-                const auto &bytecode = compile_result.value();
-                const auto chunk_name_str = std::format("={}", chunk_name);
+                // Named by path so the modules it requires can be traced back to it for hot reload
+                const auto chunk_name_str = std::format("@{}", script_info.full_path.string());
 
-                return g_pointers->m_roblox_pointers.luau_load(
+                const int status = g_pointers->m_roblox_pointers.luau_load(
                     script_thread,
                     chunk_name_str.c_str(),
-                    reinterpret_cast<const char *>(bytecode.data()),
-                    bytecode.size(),
+                    bytecode->data(),
+                    bytecode->size(),
                     0
                 );
+                loaded = status == LUA_OK;
+                if (loaded) {
+                    thread_pool.mark_loaded(script_thread);
+                }
+                return status;
             };
 
             const auto mod_context = environment::RMLProvider::ModContext{
@@ -566,28 +1258,35 @@ namespace rml::luau {
                 .mod_author = script_info.mod_author,
                 .mod_path = script_info.mod_path,
                 .mod_dependencies = script_info.mod_dependencies,
+                .mod_priority = script_info.mod_priority,
                 .mod_thread = script_thread
             };
 
-            return engine->execute_internal_with_context(
+            auto task = engine->execute_internal_with_context_task(
                 loader,
                 chunk_name,
                 mod_context,
                 RBX::Security::Permissions::RobloxEngine
             );
+
+            // The loader runs before the task is returned; the engine has copied any error off the stack by now
+            if (!loaded) {
+                thread_pool.release(script_thread);
+            }
+            return task;
         } catch (const std::exception &e) {
             LOG_ERROR("Exception in execute_script_in_mod_thread: {}", e.what());
-            std::promise<ScriptEngine::ExecutionResult> promise;
-            promise.set_value(ScriptEngine::ExecutionResult{
+            return util::make_ready_task(ScriptEngine::ExecutionResult{
                 .success = false,
                 .error_message = std::format("Exception: {}", e.what())
             });
-            return promise.get_future();
         }
     }
 
     lua_State *ScriptManager::create_mod_thread(RBX::DataModelType data_model_type,
-                                                const std::string &mod_name) noexcept {
+                                                const std::string &mod_name,
+                                                const std::size_t memory_limit,
+                                                const std::chrono::milliseconds execution_limit) noexcept {
         try {
             if (!g_task_scheduler) {
                 LOG_ERROR("TaskScheduler not available, cannot create mod thread for: {}", mod_name);
@@ -614,7 +1313,10 @@ namespace rml::luau {
                 return nullptr;
             }
 
-            luaL_sandboxthread(mod_thread); // Isolates mod context
+            environment::EnvironmentTemplate::sandbox_thread(mod_thread); // Isolates mod context
+
+            // Script threads come from this one and inherit its memory category
+            engine->get_scheduler().attach_mod_resources(mod_thread, mod_name, memory_limit, execution_limit);
 
             return mod_thread;
         } catch (const std::exception &e) {
@@ -629,7 +1331,36 @@ namespace rml::luau {
     void ScriptManager::cleanup_mod_thread(ModScriptContext &mod_context) noexcept {
         if (!mod_context.mod_thread) return;
 
+        // Nothing of it may run again, and its scripts' telemetry would otherwise outlive it
+        const auto engine = mod_context.engine.lock();
+        const bool state_alive = engine && !engine->is_destroyed();
+        if (state_alive) {
+            engine->get_scheduler().release_mod(mod_context.mod_name);
+        }
+
+        if (mod_context.thread_pool) {
+            const auto statistics = mod_context.thread_pool->get_statistics();
+            LOG_DEBUG("Thread pool for mod {}: {:.1f}% hit rate ({} of {} acquires reused), {} created, {} discarded, "
+                      "{} reclaimed with results", mod_context.mod_name, statistics.hit_rate() * 100.0,
+                      statistics.reused, statistics.acquired, statistics.created, statistics.discarded,
+                      statistics.finished_with_results);
+
+            // Threads of a state that is gone went with it
+            if (state_alive) {
+                mod_context.thread_pool->clear();
+            }
+            mod_context.thread_pool.reset();
+        }
+
+        // Functions, listeners and data subscriptions it registered on the bridge die with its threads; the cache
+        // resolves functions again after a reload
+        if (const auto bridge = environment::BridgeProvider::instance()) {
+            bridge->invalidate_luau_functions(mod_context.mod_name);
+            bridge->release_lua_callbacks(mod_context.mod_name);
+        }
+
         LOG_INFO("Cleaned up Lua thread for mod: {}", mod_context.mod_name);
         mod_context.mod_thread = nullptr;
+        mod_context.engine.reset();
     }
 }
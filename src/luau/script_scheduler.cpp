@@ -1,13 +1,81 @@
 #include "RobloxModLoader/luau/script_scheduler.hpp"
 
 #include "pointers.hpp"
+#include "RobloxModLoader/luau/execution_monitor.hpp"
 #include "RobloxModLoader/luau/script_context.hpp"
 #include "RobloxModLoader/roblox/luau/roblox_extra_space.hpp"
 #include "RobloxModLoader/roblox/security/script_permissions.hpp"
 
 namespace rml::luau {
+    namespace {
+        // Serializes the single-consumer side of the ready queues between step() and cancellation.
+        class ConsumerScope final {
+        public:
+            ConsumerScope(std::atomic_flag &flag, const bool wait) noexcept : m_flag(flag) {
+                while (m_flag.test_and_set(std::memory_order_acquire)) {
+                    if (!wait) {
+                        return;
+                    }
+                    m_flag.wait(true, std::memory_order_relaxed);
+                }
+                m_owned = true;
+            }
+
+            ~ConsumerScope() noexcept {
+                if (m_owned) {
+                    m_flag.clear(std::memory_order_release);
+                    m_flag.notify_all();
+                }
+            }
+
+            ConsumerScope(const ConsumerScope &) = delete;
+
+            ConsumerScope &operator=(const ConsumerScope &) = delete;
+
+            [[nodiscard]] explicit operator bool() const noexcept {
+                return m_owned;
+            }
+
+        private:
+            std::atomic_flag &m_flag;
+            bool m_owned{false};
+        };
+
+        // Threads that finish while resumed by Roblox's own scheduler are never seen again, so the thread ->
+        // telemetry map is dropped wholesale once it grows past this; resumes of the forgotten threads go
+        // unattributed.
+        constexpr std::size_t MAX_TRACKED_THREADS = 4096;
+
+        // Roblox attributes its own script memory to the low categories; mods get the top quarter of the 256
+        constexpr std::uint32_t FIRST_MOD_MEMORY_CATEGORY = 192;
+        constexpr std::uint32_t MEMORY_CATEGORY_COUNT = 256;
+
+        // How long a coroutine of a mod over its memory limit stays suspended before it is checked again
+        constexpr std::chrono::milliseconds MEMORY_SUSPEND_RETRY{100};
+
+        // The tighter of a run's own timeout and the mod's max_execution_time; zero means neither applies
+        std::chrono::milliseconds run_time_limit(const std::chrono::milliseconds timeout,
+                                                 const ModResourceAccount *account) noexcept {
+            const std::chrono::milliseconds mod_limit{
+                account ? account->execution_limit.load(std::memory_order_relaxed) : 0
+            };
+
+            if (mod_limit.count() <= 0) {
+                return timeout;
+            }
+            return timeout.count() > 0 ? std::min(timeout, mod_limit) : mod_limit;
+        }
+    }
+
     ScriptScheduler::ScriptScheduler(const SchedulerConfig &config)
-        : m_config(config) {
+        : m_config(config)
+          , m_next_memory_category(FIRST_MOD_MEMORY_CATEGORY) {
+        for (auto &queue: m_execution_queues) {
+            queue.reset(m_config.max_queue_size);
+        }
+        m_delayed_inbox.reset(m_config.max_queue_size);
+        m_queue_capacity = m_delayed_inbox.capacity();
+
         m_is_running.store(true, std::memory_order_release);
     }
 
@@ -22,8 +90,6 @@ namespace rml::luau {
             m_is_shutting_down.store(true, std::memory_order_release);
             m_is_running.store(false, std::memory_order_release);
 
-            m_queue_cv.notify_all();
-
             cancel_all_scripts();
 
             LOG_INFO("Script scheduler shutdown complete");
@@ -33,34 +99,101 @@ namespace rml::luau {
     }
 
     std::future<void> ScriptScheduler::schedule_script(std::unique_ptr<ExecutionContext> context) noexcept {
-        auto future = context->completion_promise.get_future();
-
         try {
-            if (!m_is_running.load(std::memory_order_acquire)) {
-                context->completion_promise.set_exception(
-                    std::make_exception_ptr(std::runtime_error("Scheduler is not running"))
-                );
-                return future;
-            } {
-                const auto priority_index = static_cast<std::size_t>(context->priority);
-                std::lock_guard lock(m_queue_mutex);
-
-                if (get_total_queue_size() >= m_config.max_queue_size) {
-                    context->completion_promise.set_exception(
-                        std::make_exception_ptr(std::runtime_error("Queue is full"))
-                    );
-                    return future;
-                }
+            auto &promise = context->completion_promise.emplace();
+            auto future = promise.get_future();
 
-                m_execution_queues[priority_index].push(std::move(context));
+            // Once admitted, the context belongs to the consumer and promise may already be gone
+            if (auto admitted = enqueue(context); !admitted) {
+                promise.set_exception(std::make_exception_ptr(std::runtime_error(admitted.error())));
             }
 
-            m_queue_cv.notify_one();
+            return future;
         } catch ([[maybe_unused]] const std::exception &e) {
-            context->completion_promise.set_exception(std::current_exception());
+            std::promise<void> failed;
+            failed.set_exception(std::current_exception());
+            return failed.get_future();
+        }
+    }
+
+    std::expected<void, std::string> ScriptScheduler::enqueue(std::unique_ptr<ExecutionContext> &context) noexcept {
+        if (!m_is_running.load(std::memory_order_acquire)) {
+            return std::unexpected("Scheduler is not running");
+        }
+
+        const auto limit = std::min(m_config.max_queue_size, m_queue_capacity);
+        if (m_queued_count.fetch_add(1, std::memory_order_acq_rel) >= limit) {
+            m_queued_count.fetch_sub(1, std::memory_order_acq_rel);
+            return std::unexpected("Queue is full");
+        }
+
+        context->enqueue_time = std::chrono::steady_clock::now();
+
+        auto &queue = context->scheduled_time > context->enqueue_time
+                          ? m_delayed_inbox
+                          : m_execution_queues[static_cast<std::size_t>(context->priority)];
+
+        if (!queue.try_push(std::move(context))) {
+            m_queued_count.fetch_sub(1, std::memory_order_acq_rel);
+            return std::unexpected("Queue is full");
         }
 
-        return future;
+        return {};
+    }
+
+    bool ScriptScheduler::ScheduleAwaiter::await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+        m_completion.continuation = awaiting;
+        m_context->completion = &m_completion;
+
+        if (auto admitted = m_scheduler.enqueue(m_context); !admitted) {
+            m_context->completion = nullptr;
+            m_completion.failed = true;
+            m_completion.error = std::move(admitted.error());
+            return false; // Resume straight away with the error
+        }
+
+        // The consumer may already be resuming the caller; nothing here can be touched any more
+        return true;
+    }
+
+    std::expected<void, std::string> ScriptScheduler::ScheduleAwaiter::await_resume() noexcept {
+        if (m_completion.failed) {
+            return std::unexpected(std::move(m_completion.error));
+        }
+        return {};
+    }
+
+    void ScriptScheduler::complete(ExecutionContext &context, const std::string_view error) noexcept {
+        try {
+            if (const auto completion = std::exchange(context.completion, nullptr)) {
+                completion->failed = !error.empty();
+                completion->error = error;
+                completion->next = m_completed;
+                m_completed = completion;
+                return;
+            }
+
+            if (context.completion_promise) {
+                if (error.empty()) {
+                    context.completion_promise->set_value();
+                } else {
+                    context.completion_promise->set_exception(
+                        std::make_exception_ptr(std::runtime_error(std::string(error))));
+                }
+                context.completion_promise.reset();
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to complete script '{}': {}", context.chunk_name, e.what());
+        }
+    }
+
+    void ScriptScheduler::resume_completed(ExecutionContext::Completion *completed) noexcept {
+        while (completed) {
+            // The resumed coroutine may free its frame, and the completion with it
+            const auto next = completed->next;
+            completed->continuation.resume();
+            completed = next;
+        }
     }
 
     std::future<void> ScriptScheduler::schedule_script_delayed(
@@ -83,7 +216,7 @@ namespace rml::luau {
                     .resume_condition = std::move(resume_condition)
                 };
                 std::lock_guard lock(m_yield_mutex);
-                m_yielded_coroutines.push_back(std::move(yielded));
+                register_yield_locked(std::move(yielded));
             }
 
             return lua_yield(L, 0);
@@ -95,30 +228,20 @@ namespace rml::luau {
 
     bool ScriptScheduler::resume_script(lua_State *L, std::any resume_data) noexcept {
         try {
-            std::lock_guard lock(m_yield_mutex);
-
-            const auto it = std::ranges::find_if(m_yielded_coroutines,
-                                                 [L](const YieldedCoroutine &yielded) {
-                                                     return yielded.thread == L;
-                                                 });
-
-            if (it != m_yielded_coroutines.end()) {
-                it->resume_data = std::move(resume_data);
+            YieldedCoroutine yielded;
+            {
+                std::lock_guard lock(m_yield_mutex);
 
-                if (const int result = lua_resume(L, nullptr, 0); result == LUA_OK || result == LUA_YIELD) {
-                    if (result == LUA_OK) {
-                        m_yielded_coroutines.erase(it);
-                    }
-                    return true;
+                const auto it = m_yielded_coroutines.find(L);
+                if (it == m_yielded_coroutines.end()) {
+                    return false;
                 }
 
-                const char *error = lua_tostring(L, -1);
-                LOG_ERROR("Error resuming script: {}", error ? error : "unknown error");
-                m_yielded_coroutines.erase(it);
-                return false;
+                yielded = take_yield_locked(it);
             }
 
-            return false;
+            yielded.resume_data = std::move(resume_data);
+            return resume_coroutine(std::move(yielded));
         } catch (const std::exception &e) {
             LOG_ERROR("Exception in resume_script: {}", e.what());
             return false;
@@ -127,38 +250,13 @@ namespace rml::luau {
 
     bool ScriptScheduler::cancel_script(lua_State *L) noexcept {
         try {
-            {
-                std::lock_guard lock(m_queue_mutex);
-
-                for (auto &queue: m_execution_queues) {
-                    std::queue<std::unique_ptr<ExecutionContext> > new_queue;
-
-                    while (!queue.empty()) {
-                        auto context = std::move(queue.front());
-                        queue.pop();
-
-                        if (context->L == L) {
-                            context->is_cancelled.store(true, std::memory_order_release);
-                            context->completion_promise.set_exception(
-                                std::make_exception_ptr(std::runtime_error("Script cancelled"))
-                            );
-                        } else {
-                            new_queue.push(std::move(context));
-                        }
-                    }
+            cancel_queued_if([L](const ExecutionContext &context) { return context.L == L; }, "Script cancelled");
 
-                    queue = std::move(new_queue);
-                }
-            } {
+            {
                 std::lock_guard lock(m_yield_mutex);
 
-                const auto it = std::ranges::find_if(m_yielded_coroutines,
-                                                     [L](const YieldedCoroutine &yielded) {
-                                                         return yielded.thread == L;
-                                                     });
-
-                if (it != m_yielded_coroutines.end()) {
-                    m_yielded_coroutines.erase(it);
+                if (const auto it = m_yielded_coroutines.find(L); it != m_yielded_coroutines.end()) {
+                    [[maybe_unused]] const auto cancelled = take_yield_locked(it);
                     return true;
                 }
             }
@@ -172,27 +270,136 @@ namespace rml::luau {
 
     void ScriptScheduler::cancel_all_scripts() noexcept {
         try {
+            cancel_queued_if([](const ExecutionContext &) { return true; }, "All scripts cancelled");
+
             {
-                std::lock_guard lock(m_queue_mutex);
+                std::lock_guard lock(m_yield_mutex);
+                m_yielded_coroutines.clear();
+                m_wait_timers = {};
+                m_condition_waiters.clear();
+                m_thread_telemetry.clear();
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Exception in cancel_all_scripts: {}", e.what());
+        }
+    }
 
-                for (auto &queue: m_execution_queues) {
-                    while (!queue.empty()) {
-                        const auto context = std::move(queue.front());
-                        queue.pop();
+    void ScriptScheduler::release_mod(const std::string &mod_name) noexcept {
+        try {
+            cancel_queued_if([&mod_name](const ExecutionContext &context) { return context.mod_name == mod_name; },
+                             "Mod was unloaded");
 
-                        context->is_cancelled.store(true, std::memory_order_release);
-                        context->completion_promise.set_exception(
-                            std::make_exception_ptr(std::runtime_error("All scripts cancelled"))
-                        );
+            {
+                // Flows cache telemetry pointers; an empty one is simply created again if the mod comes back
+                const ConsumerScope scope(m_consumer_active, true);
+
+                if (const auto it = m_mod_flows.find(mod_name); it != m_mod_flows.end()) {
+                    if (it->second.pending.empty()) {
+                        std::erase(m_active_flows, &it->second);
+                        m_mod_flows.erase(it);
+                    } else {
+                        it->second.telemetry.clear(); // Queued since the sweep, by a new instance of the mod
                     }
                 }
-            } {
+            }
+
+            {
                 std::lock_guard lock(m_yield_mutex);
-                m_yielded_coroutines.clear();
+
+                for (auto it = m_yielded_coroutines.begin(); it != m_yielded_coroutines.end();) {
+                    const auto next = std::next(it);
+                    if (it->second.telemetry && it->second.telemetry->mod_name == mod_name) {
+                        [[maybe_unused]] const auto cancelled = take_yield_locked(it);
+                    }
+                    it = next;
+                }
+
+                std::erase_if(m_thread_telemetry, [&mod_name](const auto &entry) {
+                    return entry.second->mod_name == mod_name;
+                });
             }
+
+            auto prefix = mod_name;
+            prefix.push_back('\0');
+
+            std::unique_lock lock(m_telemetry_mutex);
+            const auto released = std::erase_if(m_telemetry, [&prefix](const auto &entry) {
+                return entry.first.starts_with(prefix);
+            });
+
+            LOG_DEBUG("Released {} script telemetry entries of mod {}", released, mod_name);
         } catch (const std::exception &e) {
-            LOG_ERROR("Exception in cancel_all_scripts: {}", e.what());
+            LOG_ERROR("Exception in release_mod: {}", e.what());
+        }
+    }
+
+    std::size_t ScriptScheduler::cancel_queued_if(
+        const std::function<bool(const ExecutionContext &)> &predicate,
+        const std::string_view reason) noexcept {
+        std::size_t cancelled_count = 0;
+        ExecutionContext::Completion *completed = nullptr;
+
+        {
+            const ConsumerScope scope(m_consumer_active, true);
+
+            const auto cancel = [&](const std::unique_ptr<ExecutionContext> &context) {
+                context->is_cancelled.store(true, std::memory_order_release);
+                complete(*context, reason);
+                ++cancelled_count;
+            };
+
+            // Producers may keep pushing while we sweep; only the entries present at the start are examined and
+            // survivors are pushed back behind them.
+            for (auto &queue: m_execution_queues) {
+                for (auto remaining = queue.size_approx(); remaining > 0; --remaining) {
+                    auto context = queue.try_pop();
+                    if (!context) {
+                        break;
+                    }
+
+                    if (predicate(**context)) {
+                        cancel(*context);
+                    } else if (!queue.try_push(std::move(*context))) {
+                        cancel(*context);
+                    }
+                }
+            }
+
+            for (auto &flow: m_mod_flows | std::views::values) {
+                std::erase_if(flow.pending, [&](const std::unique_ptr<ExecutionContext> &context) {
+                    if (!predicate(*context)) {
+                        return false;
+                    }
+                    cancel(context);
+                    return true;
+                });
+
+                if (flow.active && flow.pending.empty()) {
+                    flow.active = false;
+                    flow.deficit = std::chrono::nanoseconds{0};
+                    std::erase(m_active_flows, &flow);
+                }
+            }
+
+            drain_delayed_inbox();
+
+            const auto removed = std::ranges::remove_if(m_delayed_scripts,
+                                                        [&predicate](const DelayedContext &delayed) {
+                                                            return predicate(*delayed.context);
+                                                        });
+            for (const auto &delayed: removed) {
+                cancel(delayed.context);
+            }
+            m_delayed_scripts.erase(removed.begin(), removed.end());
+            std::ranges::make_heap(m_delayed_scripts, std::greater<>{});
+            m_delayed_count.store(m_delayed_scripts.size(), std::memory_order_relaxed);
+
+            m_queued_count.fetch_sub(cancelled_count, std::memory_order_acq_rel);
+            completed = std::exchange(m_completed, nullptr);
         }
+
+        resume_completed(completed);
+        return cancelled_count;
     }
 
     bool ScriptScheduler::is_running() const noexcept {
@@ -200,46 +407,84 @@ namespace rml::luau {
     }
 
     std::size_t ScriptScheduler::get_total_queue_size() const noexcept {
-        std::size_t total = 0;
-        for (const auto &queue: m_execution_queues) {
-            total += queue.size();
-        }
-        return total;
+        return m_queued_count.load(std::memory_order_relaxed);
     }
 
     std::size_t ScriptScheduler::get_executing_script_count() const noexcept {
         return m_currently_executing.load(std::memory_order_relaxed);
     }
 
-    std::size_t ScriptScheduler::get_yielded_script_count() noexcept {
+    std::size_t ScriptScheduler::get_yielded_script_count() const noexcept {
         std::lock_guard lock(m_yield_mutex);
         return m_yielded_coroutines.size();
     }
 
-    ScriptScheduler::Statistics ScriptScheduler::get_statistics() {
+    ScriptScheduler::Statistics ScriptScheduler::get_statistics() const {
         Statistics stats;
 
         stats.total_executed = m_total_executed.load(std::memory_order_relaxed);
         stats.currently_executing = m_currently_executing.load(std::memory_order_relaxed);
-        stats.total_execution_time = m_total_execution_time.load(std::memory_order_relaxed);
+        stats.total_execution_time = std::chrono::nanoseconds{m_total_execution_time.load(std::memory_order_relaxed)};
 
         if (stats.total_executed > 0) {
             stats.average_execution_time = stats.total_execution_time / stats.total_executed;
-        } {
-            std::lock_guard lock(m_queue_mutex);
-            for (std::size_t i = 0; i < m_execution_queues.size(); ++i) {
-                stats.queue_sizes[i] = m_execution_queues[i].size();
-            }
-            stats.queued_scripts = get_total_queue_size();
-        } {
+        }
+
+        for (std::size_t i = 0; i < m_execution_queues.size(); ++i) {
+            stats.queue_sizes[i] = m_execution_queues[i].size_approx();
+        }
+        stats.delayed_scripts = m_delayed_count.load(std::memory_order_relaxed) + m_delayed_inbox.size_approx();
+        stats.queued_scripts = get_total_queue_size();
+
+        {
             std::lock_guard lock(m_yield_mutex);
             stats.yielded_scripts = m_yielded_coroutines.size();
         }
 
+        stats.mod_budget_usage = get_mod_budget_usage();
+        stats.mod_resources = get_mod_resource_usage();
+
+        stats.queue_wait = to_percentiles(m_queue_wait_histogram);
+        stats.run_time = to_percentiles(m_run_time_histogram);
+        stats.resume_time = to_percentiles(m_resume_time_histogram);
+
+        {
+            std::shared_lock lock(m_telemetry_mutex);
+            stats.script_latency.reserve(m_telemetry.size());
+
+            for (const auto &telemetry: m_telemetry | std::views::values) {
+                stats.script_latency.push_back(ScriptLatency{
+                    .mod_name = telemetry->mod_name,
+                    .chunk_name = telemetry->chunk_name,
+                    .queue_wait = to_percentiles(telemetry->queue_wait),
+                    .run_time = to_percentiles(telemetry->run_time),
+                    .resume_time = to_percentiles(telemetry->resume_time)
+                });
+            }
+        }
+
         return stats;
     }
 
+    ScriptScheduler::LatencyPercentiles ScriptScheduler::to_percentiles(
+        const util::LogLinearHistogram &histogram) noexcept {
+        const auto summary = histogram.summarize();
+
+        return LatencyPercentiles{
+            .samples = summary.count,
+            .p50 = std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(summary.p50)},
+            .p95 = std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(summary.p95)},
+            .p99 = std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(summary.p99)},
+            .max = std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(summary.max)}
+        };
+    }
+
     void ScriptScheduler::set_config(const SchedulerConfig &config) noexcept {
+        if (config.max_queue_size > m_queue_capacity) {
+            LOG_WARN("Scheduler max_queue_size {} exceeds ring buffer capacity {}, clamping",
+                     config.max_queue_size, m_queue_capacity);
+        }
+
         m_config = config;
         LOG_INFO("Updated scheduler configuration");
     }
@@ -256,117 +501,548 @@ namespace rml::luau {
         try {
             process_yielded_coroutines();
 
-            const auto context = get_next_script();
-            if (!context) {
-                return false;
+            return run_fair(std::chrono::nanoseconds::max(), 1) > 0;
+        } catch (const std::exception &e) {
+            LOG_ERROR("Exception in script_scheduler::step: {}", e.what());
+            return false;
+        }
+    }
+
+    std::size_t ScriptScheduler::step_budgeted() noexcept {
+        if (!m_is_running.load(std::memory_order_acquire)) {
+            return 0;
+        }
+
+        try {
+            process_yielded_coroutines();
+
+            return run_fair(m_config.time_slice, std::numeric_limits<std::size_t>::max());
+        } catch (const std::exception &e) {
+            LOG_ERROR("Exception in script_scheduler::step_budgeted: {}", e.what());
+            return 0;
+        }
+    }
+
+    std::vector<ScriptScheduler::ModBudgetUsage> ScriptScheduler::get_mod_budget_usage() const {
+        std::lock_guard lock(m_budget_usage_mutex);
+        return m_budget_usage;
+    }
+
+    std::uint32_t ScriptScheduler::weight_for_priority(const std::int32_t priority) noexcept {
+        constexpr std::int32_t max_weight = 64;
+        return static_cast<std::uint32_t>(std::clamp(priority + 1, 1, max_weight));
+    }
+
+    std::size_t ScriptScheduler::run_fair(const std::chrono::nanoseconds budget,
+                                          const std::size_t max_scripts) noexcept {
+        std::size_t executed = 0;
+        ExecutionContext::Completion *completed = nullptr;
+
+        {
+            const ConsumerScope scope(m_consumer_active, false);
+            if (!scope) {
+                return 0; // A cancellation sweep owns the queues; pick up work next step
+            }
+
+            executed = run_flows(budget, max_scripts);
+            completed = std::exchange(m_completed, nullptr);
+        }
+
+        // Awaiting coroutines may schedule or cancel more work, so they only run once the queues are released
+        resume_completed(completed);
+        return executed;
+    }
+
+    std::size_t ScriptScheduler::run_flows(const std::chrono::nanoseconds budget,
+                                           const std::size_t max_scripts) noexcept {
+        drain_delayed_inbox();
+        promote_due_scripts(std::chrono::steady_clock::now());
+        collect_ready_scripts();
+
+        for (auto &flow: m_mod_flows | std::views::values) {
+            flow.frame_time = std::chrono::nanoseconds{0};
+        }
+
+        const auto frame_start = std::chrono::steady_clock::now();
+        const auto quantum = std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.fair_share_quantum);
+        std::size_t executed = 0;
+
+        while (!m_active_flows.empty() && executed < max_scripts) {
+            auto *flow = m_active_flows.front();
+
+            // Out of credit: top up by its weighted quantum and let the next mod have its turn
+            if (flow->deficit <= std::chrono::nanoseconds{0}) {
+                flow->deficit += quantum * flow->weight;
+                m_active_flows.pop_front();
+                m_active_flows.push_back(flow);
+                continue;
+            }
+
+            auto context = std::move(flow->pending.front());
+            flow->pending.pop_front();
+            m_queued_count.fetch_sub(1, std::memory_order_acq_rel);
+
+            if (!flow->account) {
+                flow->account = find_resource_account(flow->mod_name);
+            }
+
+            std::chrono::nanoseconds elapsed{0};
+
+            // New work of a mod over its memory limit is refused until the collector brings it back under
+            if (flow->account && flow->account->over_limit.load(std::memory_order_relaxed)
+                && !ExecutionMonitor::refresh_memory(context->L, *flow->account)) {
+                complete(*context, std::format("Mod '{}' is over its memory limit", flow->mod_name));
+            } else {
+                auto *telemetry = telemetry_for(*flow, context->chunk_name);
+
+                // Delayed scripts only start waiting once they are due
+                const auto ready_time = std::max(context->enqueue_time, context->scheduled_time);
+                const auto queue_wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - ready_time);
+                const auto queue_wait_ns = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(
+                    queue_wait.count(), 0));
+                m_queue_wait_histogram.record(queue_wait_ns);
+                telemetry->queue_wait.record(queue_wait_ns);
+
+                {
+                    std::lock_guard lock(m_yield_mutex);
+                    if (m_thread_telemetry.size() >= MAX_TRACKED_THREADS) {
+                        m_thread_telemetry.clear();
+                    }
+                    m_thread_telemetry[context->L] = telemetry;
+                }
+
+                ScriptContext::elevate_closure(
+                    static_cast<const Closure *>(lua_topointer(context->L, -1)),
+                    RBX::Security::FULL_CAPABILITIES
+                );
+
+                elapsed = execute_script(context, flow->account);
+
+                m_run_time_histogram.record(static_cast<std::uint64_t>(elapsed.count()));
+                telemetry->run_time.record(static_cast<std::uint64_t>(elapsed.count()));
+            }
+
+            flow->deficit -= elapsed;
+            flow->frame_time += elapsed;
+            flow->total_time += elapsed;
+            ++flow->executed;
+            ++executed;
+
+            if (flow->pending.empty()) {
+                flow->deficit = std::chrono::nanoseconds{0};
+                flow->active = false;
+                m_active_flows.pop_front();
+            }
+
+            if (std::chrono::steady_clock::now() - frame_start >= budget) {
+                break;
+            }
+        }
+
+        publish_budget_usage();
+        return executed;
+    }
+
+    void ScriptScheduler::collect_ready_scripts() {
+        for (auto &queue: m_execution_queues) {
+            while (auto context = queue.try_pop()) {
+                auto &flow = m_mod_flows[(*context)->mod_name];
+                if (flow.mod_name.empty()) {
+                    flow.mod_name = (*context)->mod_name;
+                }
+                flow.weight = (*context)->mod_weight;
+
+                flow.pending.push_back(std::move(*context));
+
+                if (!flow.active) {
+                    flow.active = true;
+                    m_active_flows.push_back(&flow);
+                }
             }
+        }
+    }
+
+    void ScriptScheduler::publish_budget_usage() {
+        std::lock_guard lock(m_budget_usage_mutex);
+
+        m_budget_usage.clear();
+        m_budget_usage.reserve(m_mod_flows.size());
+
+        for (const auto &flow: m_mod_flows | std::views::values) {
+            m_budget_usage.push_back(ModBudgetUsage{
+                .mod_name = flow.mod_name,
+                .weight = flow.weight,
+                .pending_scripts = flow.pending.size(),
+                .executed_scripts = flow.executed,
+                .total_time = flow.total_time,
+                .last_frame_time = flow.frame_time,
+                .deficit = flow.deficit
+            });
+        }
+    }
+
+    ScriptScheduler::ScriptTelemetry *ScriptScheduler::telemetry_for(ModFlow &flow, const std::string &chunk_name) {
+        if (const auto it = flow.telemetry.find(chunk_name); it != flow.telemetry.end()) {
+            return it->second;
+        }
 
-            ScriptContext::elevate_closure(
-                static_cast<const Closure *>(lua_topointer(context->L, -1)),
-                RBX::Security::FULL_CAPABILITIES
-            );
+        auto key = flow.mod_name;
+        key.push_back('\0');
+        key.append(chunk_name);
 
-            execute_script(context);
-            return true;
+        std::unique_lock lock(m_telemetry_mutex);
+
+        auto &telemetry = m_telemetry[key];
+        if (!telemetry) {
+            telemetry = std::make_unique<ScriptTelemetry>();
+            telemetry->mod_name = flow.mod_name;
+            telemetry->chunk_name = chunk_name;
+            telemetry->account = flow.account;
+        }
+
+        flow.telemetry.emplace(chunk_name, telemetry.get());
+        return telemetry.get();
+    }
+
+    ModResourceAccount *ScriptScheduler::find_resource_account(const std::string &mod_name) const {
+        std::shared_lock lock(m_resource_mutex);
+
+        const auto it = m_resource_accounts.find(mod_name);
+        return it != m_resource_accounts.end() ? it->second.get() : nullptr;
+    }
+
+    ModResourceAccount *ScriptScheduler::attach_mod_resources(
+        lua_State *thread, const std::string &mod_name, const std::size_t memory_limit,
+        const std::chrono::milliseconds execution_limit) noexcept {
+        if (!thread) {
+            return nullptr;
+        }
+
+        try {
+            std::unique_lock lock(m_resource_mutex);
+
+            auto &account = m_resource_accounts[mod_name];
+            if (!account) {
+                account = std::make_unique<ModResourceAccount>();
+                account->mod_name = mod_name;
+
+                if (m_next_memory_category < MEMORY_CATEGORY_COUNT) {
+                    account->category = static_cast<std::uint8_t>(m_next_memory_category++);
+                } else {
+                    LOG_WARN("No memory category left for mod '{}'; its memory goes unaccounted", mod_name);
+                }
+            }
+
+            // Reattaching after a reload picks up changed limits
+            account->memory_limit.store(memory_limit, std::memory_order_relaxed);
+            account->execution_limit.store(execution_limit.count(), std::memory_order_relaxed);
+            if (account->category != 0) {
+                lua_setmemcat(thread, account->category);
+                ExecutionMonitor::register_account(thread, *account);
+            }
+
+            LOG_DEBUG("Mod '{}' allocates in memory category {} (limits: {} bytes, {} ms per run)", mod_name,
+                      account->category, memory_limit, execution_limit.count());
+            return account.get();
         } catch (const std::exception &e) {
-            LOG_ERROR("Exception in script_scheduler::step: {}", e.what());
-            return false;
+            LOG_ERROR("Failed to attach resource accounting for mod '{}': {}", mod_name, e.what());
+            return nullptr;
+        }
+    }
+
+    std::vector<ScriptScheduler::ModResourceUsage> ScriptScheduler::get_mod_resource_usage() const {
+        std::shared_lock lock(m_resource_mutex);
+
+        std::vector<ModResourceUsage> usage;
+        usage.reserve(m_resource_accounts.size());
+
+        for (const auto &account: m_resource_accounts | std::views::values) {
+            usage.push_back(ModResourceUsage{
+                .mod_name = account->mod_name,
+                .live_bytes = account->live_bytes.load(std::memory_order_relaxed),
+                .peak_bytes = account->peak_bytes.load(std::memory_order_relaxed),
+                .memory_limit = account->memory_limit.load(std::memory_order_relaxed),
+                .limit_hits = account->limit_hits.load(std::memory_order_relaxed),
+                .over_limit = account->over_limit.load(std::memory_order_relaxed),
+                .execution_limit = std::chrono::milliseconds{account->execution_limit.load(std::memory_order_relaxed)},
+                .overruns = account->overruns.load(std::memory_order_relaxed)
+            });
+        }
+
+        return usage;
+    }
+
+    void ScriptScheduler::record_resume(const YieldedCoroutine &yielded,
+                                        const std::chrono::nanoseconds elapsed) noexcept {
+        const auto elapsed_ns = static_cast<std::uint64_t>(elapsed.count());
+
+        m_resume_time_histogram.record(elapsed_ns);
+        if (yielded.telemetry) {
+            yielded.telemetry->resume_time.record(elapsed_ns);
         }
     }
 
     void ScriptScheduler::process_yielded_coroutines() noexcept {
         try {
-            std::lock_guard lock(m_yield_mutex);
+            m_ready_coroutines.clear();
+
+            {
+                std::lock_guard lock(m_yield_mutex);
 
-            const auto now = std::chrono::steady_clock::now();
+                const auto now = std::chrono::steady_clock::now();
 
-            for (auto it = m_yielded_coroutines.begin(); it != m_yielded_coroutines.end();) {
-                bool should_resume = false;
+                while (!m_wait_timers.empty() && m_wait_timers.top().deadline <= now) {
+                    const auto timer = m_wait_timers.top();
+                    m_wait_timers.pop();
 
-                if (it->yield_duration.count() > 0) {
-                    if (const auto elapsed = now - it->yield_time; elapsed >= it->yield_duration) {
-                        should_resume = true;
+                    const auto it = m_yielded_coroutines.find(timer.thread);
+                    if (it == m_yielded_coroutines.end() || it->second.generation != timer.generation) {
+                        continue; // Resumed, cancelled or re-yielded since this timer was armed
                     }
+
+                    m_ready_coroutines.push_back(take_yield_locked(it));
                 }
 
-                if (!should_resume && it->resume_condition) {
+                for (std::size_t slot = 0; slot < m_condition_waiters.size();) {
+                    const auto it = m_yielded_coroutines.find(m_condition_waiters[slot]);
+
+                    bool should_resume;
                     try {
-                        should_resume = it->resume_condition();
+                        should_resume = it->second.resume_condition();
                     } catch (const std::exception &e) {
                         LOG_ERROR("Exception in resume condition: {}", e.what());
                         should_resume = true;
                     }
-                }
 
-                if (should_resume) {
-                    if (const int result = lua_resume(it->thread, nullptr, 0); result == LUA_OK) {
-                        it = m_yielded_coroutines.erase(it);
-                    } else if (result == LUA_YIELD) {
-                        it->yield_time = now;
-                        ++it;
+                    if (should_resume) {
+                        // take_yield_locked moves the last waiter into this slot, so don't advance
+                        m_ready_coroutines.push_back(take_yield_locked(it));
                     } else {
-                        const char *error = lua_tostring(it->thread, -1);
-                        LOG_ERROR("Error in yielded coroutine: {}", error ? error : "unknown error");
-                        it = m_yielded_coroutines.erase(it);
+                        ++slot;
                     }
-                } else {
-                    ++it;
                 }
             }
+
+            // Resume outside the lock so a coroutine that yields again can re-register itself
+            for (auto &yielded: m_ready_coroutines) {
+                resume_coroutine(std::move(yielded));
+            }
+
+            m_ready_coroutines.clear();
         } catch (const std::exception &e) {
             LOG_ERROR("Exception in process_yielded_coroutines: {}", e.what());
         }
     }
 
-    std::unique_ptr<ScriptScheduler::ExecutionContext> ScriptScheduler::get_next_script() noexcept {
-        std::lock_guard lock(m_queue_mutex);
+    void ScriptScheduler::register_yield_locked(YieldedCoroutine yielded) {
+        if (const auto existing = m_yielded_coroutines.find(yielded.thread);
+            existing != m_yielded_coroutines.end()) {
+            [[maybe_unused]] const auto replaced = take_yield_locked(existing);
+        }
 
-        for (auto &queue: m_execution_queues) {
-            if (!queue.empty()) {
-                auto context = std::move(queue.front());
-                queue.pop();
+        yielded.generation = ++m_next_yield_generation;
+        yielded.condition_slot = YieldedCoroutine::NO_CONDITION_SLOT;
+
+        if (!yielded.telemetry) {
+            if (const auto it = m_thread_telemetry.find(yielded.thread); it != m_thread_telemetry.end()) {
+                yielded.telemetry = it->second;
+            }
+        }
+
+        if (yielded.yield_duration.count() > 0) {
+            m_wait_timers.push(WaitTimer{
+                .deadline = yielded.yield_time + yielded.yield_duration,
+                .generation = yielded.generation,
+                .thread = yielded.thread
+            });
+        }
+
+        if (yielded.resume_condition) {
+            yielded.condition_slot = m_condition_waiters.size();
+            m_condition_waiters.push_back(yielded.thread);
+        }
+
+        m_yielded_coroutines.emplace(yielded.thread, std::move(yielded));
+    }
+
+    ScriptScheduler::YieldedCoroutine ScriptScheduler::take_yield_locked(
+        const std::unordered_map<lua_State *, YieldedCoroutine>::iterator it) noexcept {
+        auto yielded = std::move(it->second);
+
+        if (const auto slot = yielded.condition_slot; slot != YieldedCoroutine::NO_CONDITION_SLOT) {
+            const auto last = m_condition_waiters.back();
+            m_condition_waiters[slot] = last;
+            m_condition_waiters.pop_back();
+
+            if (last != yielded.thread) {
+                m_yielded_coroutines.find(last)->second.condition_slot = slot;
+            }
+        }
+
+        m_yielded_coroutines.erase(it);
+        return yielded;
+    }
+
+    bool ScriptScheduler::resume_coroutine(YieldedCoroutine yielded) noexcept {
+        try {
+            auto *account = yielded.telemetry ? yielded.telemetry->account : nullptr;
+
+            if (account && account->over_limit.load(std::memory_order_relaxed)
+                && !ExecutionMonitor::refresh_memory(yielded.thread, *account)) {
+                // Stays suspended, whatever it was waiting on, until the mod is back under its limit
+                std::lock_guard lock(m_yield_mutex);
+                if (!m_yielded_coroutines.contains(yielded.thread)) {
+                    yielded.yield_time = std::chrono::steady_clock::now();
+                    yielded.yield_duration = MEMORY_SUSPEND_RETRY;
+                    yielded.resume_condition = nullptr;
+                    register_yield_locked(std::move(yielded));
+                }
+                return true;
+            }
+
+            const auto mod_name = yielded.telemetry
+                                      ? std::string_view(yielded.telemetry->mod_name)
+                                      : std::string_view{};
+
+            const auto start_time = std::chrono::steady_clock::now();
+            const int result = [&] {
+                ExecutionMonitor::Scope scope(mod_name, account,
+                                              run_time_limit(ExecutionContext::DEFAULT_TIMEOUT, account));
+                return lua_resume(yielded.thread, nullptr, 0);
+            }();
+            if (account) {
+                ExecutionMonitor::refresh_memory(yielded.thread, *account);
+            }
+            record_resume(yielded, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start_time));
+
+            if (result != LUA_YIELD) {
+                std::lock_guard lock(m_yield_mutex);
+                m_thread_telemetry.erase(yielded.thread);
+            }
+
+            if (result == LUA_OK) {
+                lua_settop(yielded.thread, 0); // As in execute_script: unread, and lets the thread pool reclaim it
+                return true;
+            }
+
+            if (result == LUA_YIELD) {
+                std::lock_guard lock(m_yield_mutex);
 
-                if (const auto now = std::chrono::steady_clock::now(); context->scheduled_time > now) {
-                    queue.push(std::move(context));
-                    continue;
+                // Coroutines that yielded through something other than yield_script keep their
+                // previous wait parameters, re-armed from now.
+                if (!m_yielded_coroutines.contains(yielded.thread)) {
+                    yielded.yield_time = std::chrono::steady_clock::now();
+                    register_yield_locked(std::move(yielded));
                 }
+                return true;
+            }
+
+            const char *error = lua_tostring(yielded.thread, -1);
+            LOG_ERROR("Error in yielded coroutine: {}", error ? error : "unknown error");
+            return false;
+        } catch (const std::exception &e) {
+            LOG_ERROR("Exception while resuming coroutine: {}", e.what());
+            return false;
+        }
+    }
+
+    void ScriptScheduler::drain_delayed_inbox() {
+        while (auto context = m_delayed_inbox.try_pop()) {
+            const auto due = (*context)->scheduled_time;
+            m_delayed_scripts.push_back(DelayedContext{
+                .due = due,
+                .sequence = m_next_delay_sequence++,
+                .context = std::move(*context)
+            });
+            std::ranges::push_heap(m_delayed_scripts, std::greater<>{});
+        }
 
-                return context;
+        m_delayed_count.store(m_delayed_scripts.size(), std::memory_order_relaxed);
+    }
+
+    void ScriptScheduler::promote_due_scripts(const std::chrono::steady_clock::time_point now) {
+        while (!m_delayed_scripts.empty() && m_delayed_scripts.front().due <= now) {
+            std::ranges::pop_heap(m_delayed_scripts, std::greater<>{});
+
+            auto context = std::move(m_delayed_scripts.back().context);
+            m_delayed_scripts.pop_back();
+
+            // Capacity always covers m_queued_count, which already accounts for this context
+            auto &queue = m_execution_queues[static_cast<std::size_t>(context->priority)];
+            if (!queue.try_push(std::move(context))) {
+                LOG_ERROR("Ready queue overflow while promoting delayed script");
+                m_queued_count.fetch_sub(1, std::memory_order_acq_rel);
+                complete(*context, "Queue is full");
             }
         }
 
-        return nullptr;
+        m_delayed_count.store(m_delayed_scripts.size(), std::memory_order_relaxed);
     }
 
-    void ScriptScheduler::execute_script(const std::unique_ptr<ExecutionContext> &context) noexcept {
-        if (!context || !context->L) {
-            return;
+    std::chrono::nanoseconds ScriptScheduler::execute_script(const std::unique_ptr<ExecutionContext> &context,
+                                                             ModResourceAccount *account) noexcept {
+        if (!context) {
+            return std::chrono::nanoseconds{0};
         }
 
+        if (!context->L) {
+            complete(*context, "Script has no thread");
+            return std::chrono::nanoseconds{0};
+        }
+
+        std::chrono::nanoseconds execution_time{0};
+
         try {
             if (context->is_cancelled.load(std::memory_order_acquire)) {
-                context->completion_promise.set_exception(
-                    std::make_exception_ptr(std::runtime_error("Script was cancelled"))
-                );
-                return;
+                complete(*context, "Script was cancelled");
+                return execution_time;
             }
 
             m_currently_executing.fetch_add(1, std::memory_order_relaxed);
 
-            const auto start_time = std::chrono::high_resolution_clock::now();
+            const auto start_time = std::chrono::steady_clock::now();
 
-            g_pointers->m_roblox_pointers.task_defer(context->L);
+            // Resumed here rather than handed to Roblox's task.defer, so the first run happens inside the scope
+            // and its deadline and memory cap, and completion means the script has run up to its end or first
+            // yield. Later resumes go through resume_coroutine or Roblox's own scheduler.
+            const int status = [&] {
+                ExecutionMonitor::Scope scope(context->mod_name, account, run_time_limit(context->timeout, account));
+                return lua_resume(context->L, nullptr, 0);
+            }();
 
-            const auto end_time = std::chrono::high_resolution_clock::now();
-            const auto execution_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+            if (account) {
+                ExecutionMonitor::refresh_memory(context->L, *account);
+            }
+
+            const auto end_time = std::chrono::steady_clock::now();
+            execution_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
 
-            m_total_execution_time.store(execution_time, std::memory_order_relaxed);
+            m_total_execution_time.fetch_add(execution_time.count(), std::memory_order_relaxed);
             m_total_executed.fetch_add(1, std::memory_order_relaxed);
-        } catch ([[maybe_unused]] const std::exception &e) {
-            context->completion_promise.set_exception(std::current_exception());
+
+            if (status != LUA_YIELD) {
+                std::lock_guard lock(m_yield_mutex);
+                m_thread_telemetry.erase(context->L);
+            }
+
+            if (status == LUA_OK) {
+                lua_settop(context->L, 0); // Nobody reads the results, and a thread with an empty stack is reusable
+                complete(*context);
+            } else if (status == LUA_YIELD) {
+                complete(*context);
+            } else {
+                // Reported by whoever scheduled it
+                const auto *message = lua_tostring(context->L, -1);
+                complete(*context, message ? message : "Script failed");
+            }
+        } catch (const std::exception &e) {
+            complete(*context, e.what());
             LOG_ERROR("Exception during script execution: {}", e.what());
         }
 
         m_currently_executing.fetch_sub(1, std::memory_order_relaxed);
+        return execution_time;
     }
 }
@@ -7,6 +7,7 @@
 #include "RobloxModLoader/memory/rtti_scanner.hpp"
 #include "RobloxModLoader/roblox/job_manager.hpp"
 #include "RobloxModLoader/roblox/task_scheduler.hpp"
+#include "RobloxModLoader/luau/bytecode_cache.hpp"
 #include "RobloxModLoader/luau/script_manager.hpp"
 #include "utils/directory_utils.hpp"
 
@@ -56,6 +57,14 @@ BOOL APIENTRY DllMain(const HMODULE hModule, const DWORD dwReason, LPVOID lpRese
             const auto hooking_instance = std::make_shared<hooking>();
             LOG_INFO("Hooking initialized.");
 
+            const auto &performance_config = rml::config::core().performance;
+            const auto bytecode_cache_instance = performance_config.enable_bytecode_cache
+                                                     ? std::make_shared<rml::luau::BytecodeCache>(
+                                                         performance_config.bytecode_cache_size,
+                                                         performance_config.enable_disk_bytecode_cache)
+                                                     : nullptr;
+            LOG_INFO("Bytecode cache {}.", bytecode_cache_instance ? "initialized" : "disabled");
+
             const auto script_manager = std::make_shared<rml::luau::ScriptManager>();
             LOG_INFO("Script Manager initialized.");
 
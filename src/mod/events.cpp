@@ -2,7 +2,21 @@
 #include "RobloxModLoader/common.hpp"
 
 namespace events {
-    EventManager::EventManager() {
+    namespace {
+        std::atomic<std::uint32_t> g_next_instance_id{1};
+
+        // The queue this thread pushes into, remembered per manager instance
+        struct ThreadQueueCache {
+            std::uint32_t instance_id{0};
+            std::shared_ptr<void> queue;
+        };
+
+        thread_local ThreadQueueCache t_queue_cache;
+    }
+
+    EventManager::EventManager()
+        : handlers(std::make_shared<const HandlerTable>())
+          , instance_id(g_next_instance_id.fetch_add(1, std::memory_order_relaxed)) {
         LOG_INFO("Event Manager initialized.");
         g_event_manager = this;
     }
@@ -10,4 +24,106 @@ namespace events {
     EventManager::~EventManager() {
         g_event_manager = nullptr;
     }
+
+    void EventManager::publish(const HandlerTable &current, const EventTypeId type_id,
+                               std::shared_ptr<const HandlerListBase> list) {
+        auto table = std::make_shared<HandlerTable>(current);
+        if (list) {
+            (*table)[type_id] = std::move(list);
+        } else {
+            table->erase(type_id);
+        }
+        handlers.store(std::move(table), std::memory_order_release);
+    }
+
+    EventManager::DeferredQueue &EventManager::thread_queue() {
+        if (t_queue_cache.instance_id == instance_id) {
+            return *static_cast<DeferredQueue *>(t_queue_cache.queue.get());
+        }
+
+        // First deferred event from this thread (since it last used another manager)
+        auto queue = std::make_shared<DeferredQueue>(DEFERRED_QUEUE_CAPACITY);
+        {
+            std::lock_guard lock(queues_mutex);
+            deferred_queues.push_back(queue);
+        }
+
+        auto &result = *queue;
+        t_queue_cache.instance_id = instance_id;
+        t_queue_cache.queue = std::move(queue);
+        return result;
+    }
+
+    void EventManager::enqueue_deferred(DeferredEvent &&deferred) {
+        // Counted first so the drain never sees an event it hasn't been told about
+        pending_deferred.fetch_add(1, std::memory_order_release);
+        if (!thread_queue().try_push(std::move(deferred))) {
+            pending_deferred.fetch_sub(1, std::memory_order_relaxed);
+            dropped_deferred.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t EventManager::dispatchDeferred(const std::size_t max_events) noexcept {
+        if (!hasDeferredEvents()) {
+            return 0;
+        }
+
+        if (drain_flag.test_and_set(std::memory_order_acquire)) {
+            return 0;
+        }
+
+        std::size_t dispatched = 0;
+
+        try {
+            std::vector<std::shared_ptr<DeferredQueue> > queues;
+            {
+                std::lock_guard lock(queues_mutex);
+                queues = deferred_queues;
+            }
+
+            // Round robin, so one busy thread can't starve the others when the budget runs out
+            bool drained_any = true;
+            while (drained_any && dispatched < max_events) {
+                drained_any = false;
+
+                for (const auto &queue: queues) {
+                    if (dispatched >= max_events) {
+                        break;
+                    }
+
+                    auto deferred = queue->try_pop();
+                    if (!deferred) {
+                        continue;
+                    }
+
+                    drained_any = true;
+                    ++dispatched;
+                    pending_deferred.fetch_sub(1, std::memory_order_acq_rel);
+
+                    try {
+                        deferred->dispatch(*this, *deferred->event);
+                    } catch (const std::exception &e) {
+                        LOG_ERROR("Deferred event handler failed: {}", e.what());
+                    }
+                }
+            }
+
+            // Once the snapshot is gone, only the list still holds the queue of a thread that exited (or moved on
+            // to another manager). Nothing pushes to it again, so it can go once drained.
+            queues.clear();
+            std::lock_guard lock(queues_mutex);
+            std::erase_if(deferred_queues, [](const std::shared_ptr<DeferredQueue> &queue) {
+                return queue.use_count() == 1 && queue->empty_approx();
+            });
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to dispatch deferred events: {}", e.what());
+        }
+
+        if (const auto dropped = dropped_deferred.exchange(0, std::memory_order_relaxed); dropped > 0) {
+            LOG_WARN("Dropped {} deferred events because their thread's queue was full", dropped);
+        }
+
+        drain_flag.clear(std::memory_order_release);
+        return dispatched;
+    }
 }
@@ -3,12 +3,22 @@
 
 #include "pointers.hpp"
 #include "RobloxModLoader/luau/script_engine.hpp"
+#include "RobloxModLoader/luau/environment/bridge_provider.hpp"
 #include "RobloxModLoader/luau/script_manager.hpp"
+#include "RobloxModLoader/mod/events.hpp"
 #include "RobloxModLoader/roblox/data_model.hpp"
 #include "RobloxModLoader/roblox/task_scheduler.hpp"
 #include "RobloxModLoader/roblox/waiting_hybrid_scripts_job.hpp"
 
 namespace rml::jobs {
+    namespace {
+        // Async bridge calls run per step; the rest stay queued for the next frame
+        constexpr std::size_t MAX_ASYNC_BRIDGE_CALLS_PER_STEP = 4096;
+
+        // Same for deferred mod event handlers
+        constexpr std::size_t MAX_DEFERRED_EVENTS_PER_STEP = 1024;
+    }
+
     LuauWaitingScriptJob::LuauWaitingScriptJob() noexcept
         : JobBase(JOB_NAME, JobPriority::High, JobKind::WaitingHybridScripts, true) {
     }
@@ -25,6 +35,20 @@ namespace rml::jobs {
             return false;
         }
 
+        if (luau::g_script_manager && (luau::g_script_manager->has_pending_script_waves() ||
+                                       luau::g_script_manager->has_pending_hot_reloads())) {
+            return true;
+        }
+
+        if (events::g_event_manager && events::g_event_manager->hasDeferredEvents()) {
+            return true;
+        }
+
+        if (const auto bridge = luau::environment::BridgeProvider::instance();
+            bridge && (bridge->has_pending_async_calls() || bridge->has_pending_shared_data_changes())) {
+            return true;
+        }
+
         const auto engine = g_task_scheduler->get_script_engine(data_model_type);
         return engine && engine->get_scheduler().get_total_queue_size();
     }
@@ -38,10 +62,40 @@ namespace rml::jobs {
 
         const auto data_model_type = data_model->get_type();
 
+        // Release the next dependency wave and any hot reloaded scripts first so they are picked up by this step
+        if (luau::g_script_manager) {
+            luau::g_script_manager->advance_script_waves(data_model_type);
+            luau::g_script_manager->process_hot_reloads();
+        }
+
+        // Mod handlers registered as deferred run here, off the hooks that emitted their events
+        if (events::g_event_manager) {
+            if (const auto dispatched = events::g_event_manager->dispatchDeferred(MAX_DEFERRED_EVENTS_PER_STEP);
+                dispatched > 0) {
+                LOG_DEBUG("[LuauWaitingScriptJob] Dispatched {} deferred events", dispatched);
+            }
+        }
+
         if (const auto engine = g_task_scheduler->get_script_engine(data_model_type)) {
-            if (auto &scheduler = const_cast<luau::ScriptScheduler &>(engine->get_scheduler()); scheduler.step()) {
-                LOG_DEBUG("[LuauWaitingScriptJob] Processed script from queue for DataModel type: {}",
-                          static_cast<int>(data_model_type));
+            if (const auto bridge = luau::environment::BridgeProvider::instance()) {
+                if (const auto calls = bridge->drain_async_calls(engine->get_context().get_thread_state(),
+                                                                 MAX_ASYNC_BRIDGE_CALLS_PER_STEP); calls > 0) {
+                    LOG_DEBUG("[LuauWaitingScriptJob] Ran {} async bridge calls for DataModel type: {}", calls,
+                              static_cast<int>(data_model_type));
+                }
+
+                // Once per frame, after the calls above had their chance to write
+                if (const auto keys = bridge->dispatch_shared_data_changes(engine->get_context().get_thread_state());
+                    keys > 0) {
+                    LOG_DEBUG("[LuauWaitingScriptJob] Dispatched {} shared data changes for DataModel type: {}",
+                              keys, static_cast<int>(data_model_type));
+                }
+            }
+
+            auto &scheduler = const_cast<luau::ScriptScheduler &>(engine->get_scheduler());
+            if (const auto executed = scheduler.step_budgeted(); executed > 0) {
+                LOG_DEBUG("[LuauWaitingScriptJob] Processed {} scripts from queue for DataModel type: {}",
+                          executed, static_cast<int>(data_model_type));
             }
         }
     }
@@ -300,7 +300,7 @@ namespace RBX {
             .L = L,
         };
 
-        luaL_sandboxthread(L);
+        // Sandboxed over the environment template when the engine initializes
 
         auto script_engine = std::make_shared<rml::luau::ScriptEngine>(options);
 
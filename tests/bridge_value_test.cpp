@@ -0,0 +1,195 @@
+#include "check.hpp"
+
+#include "RobloxModLoader/luau/environment/bridge_value.hpp"
+
+#include <lua.h>
+#include <lualib.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+    using rml::luau::environment::BridgeArena;
+    using rml::luau::environment::BridgeValue;
+
+    // Fresh state per test, closed on scope exit
+    class LuaState final {
+    public:
+        LuaState() : m_state(luaL_newstate()) {
+        }
+
+        ~LuaState() {
+            lua_close(m_state);
+        }
+
+        LuaState(const LuaState &) = delete;
+
+        LuaState &operator=(const LuaState &) = delete;
+
+        operator lua_State *() const noexcept {
+            return m_state;
+        }
+
+    private:
+        lua_State *m_state;
+    };
+
+    // Pushes {inner = {inner = ... {value = 1}}} with the given number of tables
+    void push_chain(lua_State *L, const int tables) {
+        lua_createtable(L, 0, 1);
+        lua_pushnumber(L, 1);
+        lua_setfield(L, -2, "value");
+
+        for (int i = 1; i < tables; ++i) {
+            lua_createtable(L, 0, 1);
+            lua_insert(L, -2);
+            lua_setfield(L, -2, "inner");
+        }
+    }
+
+    bool read_throws(lua_State *L, const std::string_view message) {
+        BridgeArena arena;
+        try {
+            (void) rml::luau::environment::read_bridge_value(L, -1, arena);
+        } catch (const std::runtime_error &e) {
+            return std::string_view(e.what()).find(message) != std::string_view::npos;
+        }
+        return false;
+    }
+
+    void test_scalars_round_trip() {
+        const LuaState L;
+        BridgeArena arena;
+
+        const std::string long_string(BridgeValue::SMALL_STRING_CAPACITY * 4, 'x');
+        lua_pushboolean(L, true);
+        lua_pushnumber(L, 2.5);
+        lua_pushstring(L, "short");
+        lua_pushlstring(L, long_string.data(), long_string.size());
+        lua_pushnil(L);
+
+        const auto values = rml::luau::environment::read_bridge_values(L, 1, arena);
+        CHECK(values.size() == 5);
+        lua_settop(L, 0);
+
+        rml::luau::environment::push_bridge_values(L, values);
+        CHECK(lua_gettop(L) == 5);
+        CHECK(lua_toboolean(L, 1));
+        CHECK(lua_tonumber(L, 2) == 2.5);
+        CHECK(std::string_view(lua_tostring(L, 3)) == "short");
+        CHECK(std::string_view(lua_tostring(L, 4)) == long_string);
+        CHECK(lua_isnil(L, 5));
+    }
+
+    void test_tables_round_trip() {
+        const LuaState L;
+        BridgeArena arena;
+
+        // {name = "mod", list = {10, 20, 30}, nested = {flag = true}}
+        lua_createtable(L, 0, 3);
+        lua_pushstring(L, "mod");
+        lua_setfield(L, -2, "name");
+        lua_createtable(L, 3, 0);
+        for (int i = 1; i <= 3; ++i) {
+            lua_pushnumber(L, i * 10);
+            lua_rawseti(L, -2, i);
+        }
+        lua_setfield(L, -2, "list");
+        lua_createtable(L, 0, 1);
+        lua_pushboolean(L, true);
+        lua_setfield(L, -2, "flag");
+        lua_setfield(L, -2, "nested");
+
+        const auto value = rml::luau::environment::read_bridge_value(L, -1, arena);
+        CHECK(value.kind() == BridgeValue::Kind::Table);
+        CHECK(value.as_table().size() == 3);
+        CHECK(value.find("name") && value.find("name")->as_string() == "mod");
+        CHECK(value.find("list") && value.find("list")->as_array().size() == 3);
+        CHECK(value.find("nested") && value.find("nested")->find("flag") &&
+            value.find("nested")->find("flag")->as_boolean());
+        lua_settop(L, 0);
+
+        rml::luau::environment::push_bridge_value(L, value);
+        lua_getfield(L, -1, "list");
+        CHECK(lua_objlen(L, -1) == 3);
+        lua_rawgeti(L, -1, 3);
+        CHECK(lua_tonumber(L, -1) == 30);
+        lua_pop(L, 2);
+        lua_getfield(L, -1, "nested");
+        lua_getfield(L, -1, "flag");
+        CHECK(lua_toboolean(L, -1));
+    }
+
+    void test_shared_table_is_read_once() {
+        const LuaState L;
+        BridgeArena arena;
+
+        // {a = shared, b = shared}
+        lua_createtable(L, 0, 2);
+        lua_createtable(L, 0, 1);
+        lua_pushnumber(L, 1);
+        lua_setfield(L, -2, "value");
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, "a");
+        lua_setfield(L, -2, "b");
+
+        const auto value = rml::luau::environment::read_bridge_value(L, -1, arena);
+        const auto *a = value.find("a");
+        const auto *b = value.find("b");
+        CHECK(a && b);
+        CHECK(a && b && a->as_table().data() == b->as_table().data());
+    }
+
+    void test_cycle_throws() {
+        const LuaState L;
+
+        // t.self = t
+        lua_createtable(L, 0, 1);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -2, "self");
+
+        CHECK(read_throws(L, "cyclic"));
+    }
+
+    void test_depth_limit() {
+        const LuaState L;
+        BridgeArena arena;
+
+        push_chain(L, 20);
+        const auto value = rml::luau::environment::read_bridge_value(L, -1, arena);
+        CHECK(value.find("inner") != nullptr);
+        lua_settop(L, 0);
+
+        push_chain(L, 1000);
+        CHECK(read_throws(L, "nested too deeply"));
+    }
+
+    void test_shallow_read_never_throws() {
+        const LuaState L;
+        BridgeArena arena;
+
+        // t = {name = "x", self = t, deep = <1000 tables>}
+        lua_createtable(L, 0, 3);
+        lua_pushstring(L, "x");
+        lua_setfield(L, -2, "name");
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -2, "self");
+        push_chain(L, 1000);
+        lua_setfield(L, -2, "deep");
+
+        const auto value = rml::luau::environment::read_bridge_value(L, -1, arena, false);
+        CHECK(value.as_table().size() == 1);
+        CHECK(value.find("name") && value.find("name")->as_string() == "x");
+    }
+}
+
+int main() {
+    test_scalars_round_trip();
+    test_tables_round_trip();
+    test_shared_table_is_read_once();
+    test_cycle_throws();
+    test_depth_limit();
+    test_shallow_read_never_throws();
+    return rml::test::result();
+}
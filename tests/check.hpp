@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdio>
+
+namespace rml::test {
+    inline int g_failures = 0;
+
+    // Exit code for main: non-zero once any CHECK failed
+    [[nodiscard]] inline int result() noexcept {
+        if (g_failures != 0) {
+            std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        }
+        return g_failures == 0 ? 0 : 1;
+    }
+}
+
+// Records a failure and keeps going, so one run reports every broken case
+#define CHECK(expression)                                                                      \
+    do {                                                                                       \
+        if (!(expression)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expression); \
+            ++rml::test::g_failures;                                                           \
+        }                                                                                      \
+    } while (false)
@@ -0,0 +1,77 @@
+#include "check.hpp"
+
+#include "RobloxModLoader/util/glob_pattern.hpp"
+
+namespace {
+    bool matches(const std::string_view pattern, const std::string_view path) {
+        const auto glob = rml::util::GlobPattern::compile(pattern);
+        CHECK(glob.has_value());
+        return glob && glob->matches(path);
+    }
+
+    void test_star_stays_in_segment() {
+        CHECK(matches("*.lua", "init.lua"));
+        CHECK(!matches("*.lua", "client/init.lua"));
+        CHECK(matches("client/*.lua", "client/init.lua"));
+        CHECK(!matches("*.lua", "init.luau"));
+        CHECK(matches("*", ""));
+    }
+
+    void test_question_mark_and_classes() {
+        CHECK(matches("mod?.lua", "mod1.lua"));
+        CHECK(!matches("mod?.lua", "mod/.lua"));
+        CHECK(matches("[a-c]*.lua", "b.lua"));
+        CHECK(!matches("[a-c]*.lua", "d.lua"));
+        CHECK(matches("[!a-c]*.lua", "d.lua"));
+        CHECK(matches("[^a-c]*.lua", "d.lua"));
+        CHECK(matches("[]]x", "]x"));
+        CHECK(!matches("a[/]b", "a/b"));
+        CHECK(!rml::util::GlobPattern::compile("[abc").has_value());
+    }
+
+    void test_case_insensitive() {
+        CHECK(matches("Client/*.LUA", "client/Init.lua"));
+        CHECK(matches("[A-C].lua", "b.lua"));
+    }
+
+    void test_globstar_directories() {
+        CHECK(matches("**/*.lua", "init.lua"));
+        CHECK(matches("**/*.lua", "a/b/c/init.lua"));
+        CHECK(matches("client/**/init.lua", "client/init.lua"));
+        CHECK(matches("client/**/init.lua", "client/a/b/init.lua"));
+        CHECK(!matches("client/**/init.lua", "server/a/init.lua"));
+        CHECK(!matches("client/**/init.lua", "clientx/init.lua"));
+    }
+
+    void test_globstar_inside_segment() {
+        CHECK(matches("a**", "a/b/c"));
+        CHECK(matches("**", "a/b/c.lua"));
+        CHECK(matches("a**/x", "ab/c/x"));
+        CHECK(!matches("a**/x", "x"));
+    }
+
+    void test_triple_star_is_not_a_directory_segment() {
+        // "***/" is a globstar followed by a literal '/', so at least one separator has to be there
+        CHECK(matches("***/init.lua", "a/b/init.lua"));
+        CHECK(matches("***/init.lua", "/init.lua"));
+        CHECK(!matches("***/init.lua", "init.lua"));
+        CHECK(!matches("client/***/init.lua", "client/init.lua"));
+        CHECK(matches("client/***/init.lua", "client/a/init.lua"));
+    }
+
+    void test_pattern_length_limit() {
+        const std::string long_pattern(rml::util::GlobPattern::MAX_STATES, 'a');
+        CHECK(!rml::util::GlobPattern::compile(long_pattern).has_value());
+    }
+}
+
+int main() {
+    test_star_stays_in_segment();
+    test_question_mark_and_classes();
+    test_case_insensitive();
+    test_globstar_directories();
+    test_globstar_inside_segment();
+    test_triple_star_is_not_a_directory_segment();
+    test_pattern_length_limit();
+    return rml::test::result();
+}
@@ -0,0 +1,98 @@
+#include "check.hpp"
+
+#include "RobloxModLoader/util/log_linear_histogram.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+    using rml::util::LogLinearHistogram;
+
+    void test_buckets_bound_their_values() {
+        bool contained = true;
+        bool precise = true;
+        for (std::uint64_t value = 0; value < 100000; value += value < 64 ? 1 : 37) {
+            const auto upper = LogLinearHistogram::bucket_upper_bound(LogLinearHistogram::bucket_for(value));
+            contained = contained && upper >= value;
+            precise = precise && (upper - value) * LogLinearHistogram::SUB_BUCKETS <= value;
+        }
+        CHECK(contained);
+        CHECK(precise);
+
+        // Small values get a bucket each
+        CHECK(LogLinearHistogram::bucket_for(5) == 5);
+        CHECK(LogLinearHistogram::bucket_upper_bound(5) == 5);
+    }
+
+    void test_huge_values_land_in_the_last_bucket() {
+        CHECK(LogLinearHistogram::bucket_for(std::uint64_t{1} << 50) == LogLinearHistogram::BUCKET_COUNT - 1);
+        CHECK(LogLinearHistogram::bucket_for(UINT64_MAX) == LogLinearHistogram::BUCKET_COUNT - 1);
+    }
+
+    void test_empty_summary() {
+        const LogLinearHistogram histogram;
+        const auto summary = histogram.summarize();
+        CHECK(summary.count == 0);
+        CHECK(summary.p50 == 0 && summary.p99 == 0 && summary.max == 0);
+    }
+
+    void test_percentiles_are_within_bucket_precision() {
+        LogLinearHistogram histogram;
+        for (std::uint64_t value = 1; value <= 1000; ++value) {
+            histogram.record(value);
+        }
+
+        const auto near = [](const std::uint64_t reported, const std::uint64_t expected) {
+            return reported >= expected && reported - expected <= expected / LogLinearHistogram::SUB_BUCKETS;
+        };
+
+        const auto summary = histogram.summarize();
+        CHECK(summary.count == 1000);
+        CHECK(summary.max == 1000);
+        CHECK(near(summary.p50, 500));
+        CHECK(near(summary.p95, 950));
+        CHECK(near(summary.p99, 990));
+    }
+
+    void test_percentiles_never_exceed_max() {
+        LogLinearHistogram histogram;
+        histogram.record(1025);
+
+        const auto summary = histogram.summarize();
+        CHECK(summary.p50 == 1025);
+        CHECK(summary.p99 == 1025);
+    }
+
+    void test_concurrent_records_are_all_counted() {
+        constexpr std::size_t THREADS = LogLinearHistogram::SHARD_COUNT * 2;
+        constexpr std::uint64_t PER_THREAD = 10000;
+
+        LogLinearHistogram histogram;
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t t = 0; t < THREADS; ++t) {
+                threads.emplace_back([&histogram, t] {
+                    for (std::uint64_t i = 0; i < PER_THREAD; ++i) {
+                        histogram.record(i + t);
+                    }
+                });
+            }
+        }
+
+        const auto summary = histogram.summarize();
+        CHECK(summary.count == THREADS * PER_THREAD);
+        CHECK(summary.max == PER_THREAD - 1 + (THREADS - 1));
+    }
+}
+
+int main() {
+    test_buckets_bound_their_values();
+    test_huge_values_land_in_the_last_bucket();
+    test_empty_summary();
+    test_percentiles_are_within_bucket_precision();
+    test_percentiles_never_exceed_max();
+    test_concurrent_records_are_all_counted();
+    return rml::test::result();
+}
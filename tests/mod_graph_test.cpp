@@ -0,0 +1,124 @@
+#include "check.hpp"
+
+#include "RobloxModLoader/luau/mod_graph.hpp"
+
+#include <algorithm>
+
+namespace {
+    using rml::luau::ModGraph;
+
+    ModGraph::Node node(std::string id, std::vector<std::string> dependencies = {}, const std::int32_t priority = 0) {
+        auto name = id + " Mod";
+        return ModGraph::Node{
+            .id = std::move(id),
+            .name = std::move(name),
+            .priority = priority,
+            .dependencies = std::move(dependencies)
+        };
+    }
+
+    void test_independent_mods_share_a_wave() {
+        const auto plan = ModGraph::solve({node("a"), node("b"), node("c")});
+
+        CHECK(plan.waves.size() == 1);
+        CHECK(plan.waves.size() == 1 && plan.waves[0].size() == 3);
+        CHECK(plan.errors.empty());
+    }
+
+    void test_chain_gives_one_wave_per_link() {
+        const auto plan = ModGraph::solve({node("c", {"b"}), node("b", {"a"}), node("a")});
+
+        CHECK(plan.waves.size() == 3);
+        CHECK(plan.wave_of[2] == 0);
+        CHECK(plan.wave_of[1] == 1);
+        CHECK(plan.wave_of[0] == 2);
+    }
+
+    void test_diamond_waits_for_the_longest_path() {
+        // d depends on b and c, which both depend on a; c also depends on b
+        const auto plan = ModGraph::solve({
+            node("a"), node("b", {"a"}), node("c", {"a", "b"}), node("d", {"b", "c"})
+        });
+
+        CHECK(plan.waves.size() == 4);
+        CHECK(plan.wave_of[0] == 0);
+        CHECK(plan.wave_of[1] == 1);
+        CHECK(plan.wave_of[2] == 2);
+        CHECK(plan.wave_of[3] == 3);
+    }
+
+    void test_dependencies_match_id_or_name() {
+        const auto plan = ModGraph::solve({node("a"), node("b", {"a Mod"}), node("c", {"a"})});
+
+        CHECK(plan.errors.empty());
+        CHECK(plan.wave_of[1] == 1);
+        CHECK(plan.wave_of[2] == 1);
+    }
+
+    void test_priority_orders_within_a_wave() {
+        const auto plan = ModGraph::solve({node("low", {}, 0), node("high", {}, 5), node("mid", {}, 2)});
+
+        CHECK(plan.waves.size() == 1);
+        CHECK(plan.waves.size() == 1 && plan.waves[0] == std::vector<std::size_t>({1, 2, 0}));
+    }
+
+    void test_missing_dependency_rejects_mod_and_dependents() {
+        const auto plan = ModGraph::solve({node("a", {"missing"}), node("b", {"a"}), node("c")});
+
+        CHECK(plan.is_rejected(0));
+        CHECK(plan.is_rejected(1));
+        CHECK(!plan.is_rejected(2));
+        CHECK(plan.errors.size() == 2);
+        CHECK(plan.waves.size() == 1);
+    }
+
+    void test_satisfied_dependencies_need_no_edge() {
+        const auto plan = ModGraph::solve({node("b", {"a"})}, {"a"});
+
+        CHECK(!plan.is_rejected(0));
+        CHECK(plan.wave_of[0] == 0);
+        CHECK(plan.errors.empty());
+    }
+
+    void test_cycle_is_rejected_and_named() {
+        const auto plan = ModGraph::solve({node("a", {"c"}), node("b", {"a"}), node("c", {"b"}), node("d")});
+
+        CHECK(plan.is_rejected(0));
+        CHECK(plan.is_rejected(1));
+        CHECK(plan.is_rejected(2));
+        CHECK(!plan.is_rejected(3));
+        CHECK(plan.errors.size() == 3);
+        CHECK(std::ranges::all_of(plan.errors, [](const std::string &error) {
+            return error.find("dependency cycle") != std::string::npos;
+        }));
+        CHECK(!plan.errors.empty() && plan.errors[0].find("a Mod -> c Mod -> b Mod -> a Mod") != std::string::npos);
+    }
+
+    void test_mod_downstream_of_cycle_is_rejected() {
+        const auto plan = ModGraph::solve({node("a", {"b"}), node("b", {"a"}), node("c", {"a"})});
+
+        CHECK(plan.is_rejected(2));
+        CHECK(plan.waves.empty());
+    }
+
+    void test_self_dependency_is_a_cycle() {
+        const auto plan = ModGraph::solve({node("a", {"a"})});
+
+        CHECK(plan.is_rejected(0));
+        CHECK(plan.errors.size() == 1);
+    }
+}
+
+int main() {
+    test_independent_mods_share_a_wave();
+    test_chain_gives_one_wave_per_link();
+    test_diamond_waits_for_the_longest_path();
+    test_dependencies_match_id_or_name();
+    test_priority_orders_within_a_wave();
+    test_missing_dependency_rejects_mod_and_dependents();
+    test_satisfied_dependencies_need_no_edge();
+    test_cycle_is_rejected_and_named();
+    test_mod_downstream_of_cycle_is_rejected();
+    test_self_dependency_is_a_cycle();
+    return rml::test::result();
+}
@@ -0,0 +1,103 @@
+#include "check.hpp"
+
+#include "RobloxModLoader/util/mpsc_ring_buffer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    using rml::util::MpscRingBuffer;
+
+    void test_capacity_rounds_up_to_a_power_of_two() {
+        CHECK(MpscRingBuffer<int>(5).capacity() == 8);
+        CHECK(MpscRingBuffer<int>(8).capacity() == 8);
+        CHECK(MpscRingBuffer<int>(0).capacity() == 2);
+    }
+
+    void test_pops_in_push_order() {
+        MpscRingBuffer<int> buffer(8);
+        for (int i = 0; i < 5; ++i) {
+            CHECK(buffer.try_push(int{i}));
+        }
+        CHECK(buffer.size_approx() == 5);
+
+        for (int i = 0; i < 5; ++i) {
+            const auto value = buffer.try_pop();
+            CHECK(value && *value == i);
+        }
+        CHECK(!buffer.try_pop());
+        CHECK(buffer.empty_approx());
+    }
+
+    void test_full_buffer_rejects_and_keeps_the_value() {
+        MpscRingBuffer<std::unique_ptr<int> > buffer(2);
+        CHECK(buffer.try_push(std::make_unique<int>(1)));
+        CHECK(buffer.try_push(std::make_unique<int>(2)));
+
+        auto rejected = std::make_unique<int>(3);
+        CHECK(!buffer.try_push(std::move(rejected)));
+        CHECK(rejected && *rejected == 3);
+
+        // A freed slot is reused once the consumer has moved past it
+        CHECK(buffer.try_pop());
+        CHECK(buffer.try_push(std::move(rejected)));
+        CHECK(!rejected);
+    }
+
+    void test_wraps_around_many_times() {
+        MpscRingBuffer<std::size_t> buffer(4);
+        for (std::size_t i = 0; i < 1000; ++i) {
+            CHECK(buffer.try_push(std::size_t{i}));
+            const auto value = buffer.try_pop();
+            CHECK(value && *value == i);
+        }
+    }
+
+    void test_concurrent_producers_lose_nothing() {
+        constexpr std::size_t PRODUCERS = 4;
+        constexpr std::size_t PER_PRODUCER = 20000;
+
+        MpscRingBuffer<std::size_t> buffer(256);
+        std::vector<std::jthread> producers;
+        for (std::size_t p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&buffer, p] {
+                for (std::size_t i = 0; i < PER_PRODUCER; ++i) {
+                    while (!buffer.try_push(p * PER_PRODUCER + i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // Each producer's values arrive in the order it pushed them
+        std::vector<std::size_t> next(PRODUCERS, 0);
+        std::size_t received = 0;
+        bool ordered = true;
+        while (received < PRODUCERS * PER_PRODUCER) {
+            const auto value = buffer.try_pop();
+            if (!value) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto producer = *value / PER_PRODUCER;
+            ordered = ordered && *value % PER_PRODUCER == next[producer];
+            ++next[producer];
+            ++received;
+        }
+
+        CHECK(ordered);
+        CHECK(!buffer.try_pop());
+    }
+}
+
+int main() {
+    test_capacity_rounds_up_to_a_power_of_two();
+    test_pops_in_push_order();
+    test_full_buffer_rejects_and_keeps_the_value();
+    test_wraps_around_many_times();
+    test_concurrent_producers_lose_nothing();
+    return rml::test::result();
+}